@@ -0,0 +1,175 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+#include "arg.h"
+#include "blake3.h"
+
+static const char *backends[] = {
+	"portable", "sse2", "sse41", "avx2", "avx512",
+};
+
+static const char *argv0;
+static volatile unsigned char sink;
+
+static void
+usage(void)
+{
+	fprintf(stderr, "usage: %s [-p] [-m maxsize | -l size[,size...]] [-t seconds] [backend...]\n", argv0);
+	exit(1);
+}
+
+static double
+now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* Time stamp counter, or 0 where there is none. On x86 this counts at a
+ * fixed reference rate, which can differ from the core clock under turbo
+ * or power saving. */
+static uint64_t
+cycles(void)
+{
+#if defined(__x86_64__)
+	return __rdtsc();
+#else
+	return 0;
+#endif
+}
+
+static void
+hash(const unsigned char *buf, size_t len, int parallel)
+{
+	blake3_hasher ctx;
+	unsigned char out[BLAKE3_OUT_LEN];
+
+	blake3_hasher_init(&ctx);
+	if (parallel)
+		blake3_hasher_update(&ctx, buf, len);
+	else
+		blake3_hasher_update_parallel(&ctx, buf, len, NULL);
+	blake3_hasher_finalize(&ctx, out, sizeof(out));
+	sink ^= out[0];
+}
+
+static void
+bench(const char *backend, const unsigned char *buf, size_t len, double mintime, int parallel)
+{
+	unsigned long iters, i;
+	uint64_t c0, c1;
+	double t0, t1;
+
+	/* warm up caches and page in the input */
+	hash(buf, len, parallel);
+	for (iters = 1;; iters *= 2) {
+		t0 = now();
+		c0 = cycles();
+		for (i = 0; i < iters; i++)
+			hash(buf, len, parallel);
+		c1 = cycles();
+		t1 = now();
+		if (t1 - t0 >= mintime)
+			break;
+	}
+	printf("%s,%zu,%lu,%.0f,%.4f,%.3f\n", backend, len, iters,
+	       (t1 - t0) * 1e9,
+	       (double)len * iters / (t1 - t0) / (1 << 30),
+	       (double)(c1 - c0) / ((double)len * iters));
+	fflush(stdout);
+}
+
+int
+main(int argc, char *argv[])
+{
+	unsigned char *buf;
+	size_t i, j, len, maxlen = (size_t)1 << 30;
+	size_t sizes[64], nsizes = 0;
+	double mintime = 0.1;
+	int parallel = 0, maxset = 0, found;
+	char *end;
+
+	argv0 = argc ? argv[0] : "b3bench";
+	ARGBEGIN {
+	case 'l':
+		/* exact sizes instead of the 4x ladder, e.g. message sizes */
+		end = EARGF(usage());
+		for (;;) {
+			if (nsizes == sizeof(sizes) / sizeof(sizes[0]))
+				usage();
+			len = strtoul(end, &end, 10);
+			if (len == 0 || (*end && *end != ','))
+				usage();
+			sizes[nsizes++] = len;
+			if (!*end++)
+				break;
+		}
+		break;
+	case 'm':
+		maxlen = strtoul(EARGF(usage()), &end, 10);
+		if (*end || maxlen == 0)
+			usage();
+		maxset = 1;
+		break;
+	case 'p':
+		parallel = 1;
+		break;
+	case 't':
+		mintime = strtod(EARGF(usage()), &end);
+		if (*end)
+			usage();
+		break;
+	default:
+		usage();
+	} ARGEND
+	/* -l replaces the ladder that -m caps */
+	if (nsizes && maxset)
+		usage();
+	if (nsizes) {
+		for (maxlen = sizes[0], i = 1; i < nsizes; i++)
+			if (sizes[i] > maxlen)
+				maxlen = sizes[i];
+	}
+
+	buf = malloc(maxlen);
+	if (!buf) {
+		perror(argv0);
+		return 1;
+	}
+	for (i = 0; i < maxlen; i++)
+		buf[i] = i % 251;
+
+	printf("backend,bytes,iterations,ns,gib_per_sec,cycles_per_byte\n");
+	for (i = 0; i < sizeof(backends) / sizeof(backends[0]); i++) {
+		if (argc > 0) {
+			found = 0;
+			for (j = 0; j < (size_t)argc; j++)
+				found |= strcmp(argv[j], backends[i]) == 0;
+			if (!found)
+				continue;
+		}
+		/* skip backends this build or CPU doesn't have */
+		if (blake3_set_backend(backends[i]) != 0)
+			continue;
+		for (j = 0; j < nsizes; j++)
+			bench(backends[i], buf, sizes[j], mintime, parallel);
+		for (len = 1; !nsizes && len <= maxlen; len *= 4) {
+			bench(backends[i], buf, len, mintime, parallel);
+			if (len > maxlen / 4)
+				break;
+		}
+	}
+	blake3_set_backend(NULL);
+	free(buf);
+
+	return 0;
+}
@@ -1,56 +1,1233 @@
+#define _POSIX_C_SOURCE 200809L
+#ifdef __linux__
+/* for O_DIRECT and syscall */
+#define _GNU_SOURCE
+#endif
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#ifdef WITH_THREADS
+#include <pthread.h>
+#endif
+#ifdef WITH_URING
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
 
 #include "arg.h"
 #include "blake3.h"
 
+/* files shorter than this are cheaper to read than to map */
+#define MAPMIN 16384
+/* size and alignment of reads with -d */
+#define DIRECTBUF (1 << 20)
+#define DIRECTALIGN 4096
+/* number of queued jobs per worker thread */
+#define WINDOW 16
+/* the most directories walk holds open at once */
+#define WALKFDS 256
+/* cache file header, followed by fixed-size little-endian entries */
+#define CACHEMAGIC "b3cache1"
+#define ENTRYLEN (5 * 8 + BLAKE3_OUT_LEN)
+/* Timestamp granularity assumed by the racy check: the kernel's coarse
+ * clock for file systems with subsecond timestamps, and FAT's two seconds
+ * for those with whole seconds. */
+#define RACYFINE 100000000
+#define RACYCOARSE 2000000000
+
+/* A cached digest, valid as long as the file's metadata is unchanged. */
+struct entry {
+	uint64_t dev, ino, size, mtime, ctime;
+	unsigned char sum[BLAKE3_OUT_LEN];
+	int used;  /* looked up in this run */
+	int stale; /* the file has changed since, so dropped when saving */
+};
+
+/* Entries loaded from the cache file, sorted by device and inode, and the
+ * entries added since. Workers only read the loaded entries, and only the
+ * main thread adds new ones or marks them. */
+struct cache {
+	const char *path;
+	int prune; /* drop loaded entries that weren't used */
+	struct entry *ents;
+	size_t len;
+	struct entry *added;
+	size_t nadded, cap;
+};
+
+#ifdef WITH_URING
+/* reads in flight per thread, and the size of each */
+#define URINGDEPTH 4
+#define URINGBUF (1 << 20)
+
+/* An io_uring instance and its read buffers, used by one thread. */
+struct uring {
+	int fd;
+	int fixed;          /* buffers are registered */
+	unsigned char *buf; /* URINGDEPTH buffers of URINGBUF bytes */
+	void *sqmap, *cqmap;
+	size_t sqmaplen, cqmaplen;
+	struct io_uring_sqe *sqes;
+	size_t sqeslen;
+	unsigned *sqhead, *sqtail, *sqmask, *sqarray;
+	unsigned *cqhead, *cqtail, *cqmask;
+	struct io_uring_cqe *cqes;
+	unsigned pending;   /* queued but not yet submitted */
+	int done[URINGDEPTH];
+	int res[URINGDEPTH];
+	off_t off[URINGDEPTH];
+	size_t len[URINGDEPTH];
+};
+static void uringclose(struct uring *);
+#else
+struct uring;
+#define uringopen() NULL
+#define uringclose(r) ((void)(r))
+#endif
+
+/* I/O state kept by each thread that runs jobs. */
+struct reader {
+	struct uring *ring; /* or NULL */
+	unsigned char *buf; /* DIRECTBUF bytes for -d, allocated on first use */
+};
+
+/* A file to hash. Jobs are run by any worker, but reported by the main
+ * thread in the order they were queued. */
+struct job {
+	int (*report)(struct job *);
+	const char *name;
+	FILE *file;        /* already open file, or NULL to open name */
+	const char *mode;
+	const char *skip;  /* reason to skip a checklist line, or NULL */
+	const char *op;    /* failed operation, or NULL on success */
+	int err;
+	int done;
+	size_t outlen;
+	int store;          /* add ent to the cache */
+	struct entry ent;
+	struct entry *hit;  /* cache entry that supplied the checksum */
+	struct entry *old;  /* cache entry of the file before it changed */
+	unsigned char *sum; /* expected checksum for -c */
+	unsigned char out[];
+};
+
+struct pool {
+	struct job **jobs; /* ring of queued and running jobs */
+	size_t size;
+	size_t head;       /* next job to report */
+	size_t next;       /* next job to run */
+	size_t tail;       /* next free slot */
+#ifdef WITH_THREADS
+	pthread_mutex_t lock;
+	pthread_cond_t queued;
+	pthread_cond_t finished;
+	pthread_t *threads;
+	size_t nthreads;
+	int closed;
+#endif
+	struct reader reader; /* for jobs run on the calling thread */
+};
+
 static const char *argv0;
-static unsigned char *out;
 static size_t outlen = BLAKE3_OUT_LEN;
+static int direct;
+static struct pool pool;
+static struct cache cache;
+static size_t walkfds = 1; /* directories walk may hold open */
 
 static void
 usage(void)
 {
-	fprintf(stderr, "usage: %s [-bct] [-l length] [file...]\n", argv0);
+	fprintf(stderr, "usage: %s [-bcdprt] [-C cache] [-j jobs] [-l length] [file...]\n", argv0);
 	exit(1);
 }
 
+static void
+putle64(unsigned char *p, uint64_t x)
+{
+	int i;
+
+	for (i = 0; i < 8; i++)
+		p[i] = x >> 8 * i;
+}
+
+static uint64_t
+getle64(const unsigned char *p)
+{
+	uint64_t x = 0;
+	int i;
+
+	for (i = 0; i < 8; i++)
+		x |= (uint64_t)p[i] << 8 * i;
+	return x;
+}
+
+static void
+statentry(const struct stat *st, struct entry *ent)
+{
+	ent->dev = st->st_dev;
+	ent->ino = st->st_ino;
+	ent->size = st->st_size;
+	ent->mtime = (uint64_t)st->st_mtim.tv_sec * 1000000000 + st->st_mtim.tv_nsec;
+	ent->ctime = (uint64_t)st->st_ctim.tv_sec * 1000000000 + st->st_ctim.tv_nsec;
+}
+
+static int
+entrycmp(const void *a, const void *b)
+{
+	const struct entry *x = a, *y = b;
+
+	if (x->dev != y->dev)
+		return x->dev < y->dev ? -1 : 1;
+	if (x->ino != y->ino)
+		return x->ino < y->ino ? -1 : 1;
+	return 0;
+}
+
+/* Load the cache file, if there is one. A cache that can't be read is
+ * only a warning, since it will be rewritten. */
+static void
+cacheload(struct cache *c, const char *path)
+{
+	unsigned char buf[ENTRYLEN];
+	struct entry *ent;
+	size_t cap = 0, i, j;
+	FILE *file;
+
+	c->path = path;
+	file = fopen(path, "rb");
+	if (!file) {
+		if (errno != ENOENT)
+			fprintf(stderr, "%s: open %s: %s\n", argv0, path, strerror(errno));
+		return;
+	}
+	if (fread(buf, 1, 8, file) != 8 || memcmp(buf, CACHEMAGIC, 8) != 0) {
+		fprintf(stderr, "%s: %s: not a cache file, ignoring it\n", argv0, path);
+		fclose(file);
+		return;
+	}
+	while (fread(buf, 1, ENTRYLEN, file) == ENTRYLEN) {
+		if (c->len == cap) {
+			cap = cap ? cap * 2 : 1024;
+			ent = realloc(c->ents, cap * sizeof(*ent));
+			if (!ent) {
+				perror(argv0);
+				exit(1);
+			}
+			c->ents = ent;
+		}
+		ent = &c->ents[c->len++];
+		ent->dev = getle64(buf);
+		ent->ino = getle64(buf + 8);
+		ent->size = getle64(buf + 16);
+		ent->mtime = getle64(buf + 24);
+		ent->ctime = getle64(buf + 32);
+		memcpy(ent->sum, buf + 40, BLAKE3_OUT_LEN);
+		ent->used = 0;
+		ent->stale = 0;
+	}
+	fclose(file);
+	qsort(c->ents, c->len, sizeof(c->ents[0]), entrycmp);
+	/* cachesave writes no duplicates, but don't rely on that */
+	for (i = j = 0; i < c->len; i++) {
+		if (j > 0 && entrycmp(&c->ents[j - 1], &c->ents[i]) == 0)
+			continue;
+		c->ents[j++] = c->ents[i];
+	}
+	c->len = j;
+}
+
+static int
+samefile(const struct entry *a, const struct entry *b)
+{
+	return a->dev == b->dev && a->ino == b->ino && a->size == b->size && a->mtime == b->mtime && a->ctime == b->ctime;
+}
+
+/* The loaded entry for key's device and inode, which may describe an
+ * earlier version of the file. */
+static struct entry *
+cachefind(const struct cache *c, const struct entry *key)
+{
+	if (c->len == 0)
+		return NULL;
+	return bsearch(key, c->ents, c->len, sizeof(c->ents[0]), entrycmp);
+}
+
+/* Whether cachesave keeps a loaded entry. Entries of files that weren't
+ * looked up are kept unless pruning, since they may belong to files
+ * hashed by other runs. */
+static int
+cachekeep(const struct cache *c, const struct entry *ent)
+{
+	return !ent->stale && (ent->used || !c->prune);
+}
+
+static void
+cacheadd(struct cache *c, const struct entry *ent)
+{
+	struct entry *added;
+
+	if (c->nadded == c->cap) {
+		c->cap = c->cap ? c->cap * 2 : 64;
+		added = realloc(c->added, c->cap * sizeof(*added));
+		if (!added) {
+			perror(argv0);
+			exit(1);
+		}
+		c->added = added;
+	}
+	c->added[c->nadded++] = *ent;
+}
+
+static int
+writeentry(FILE *file, const struct entry *ent)
+{
+	unsigned char buf[ENTRYLEN];
+
+	putle64(buf, ent->dev);
+	putle64(buf + 8, ent->ino);
+	putle64(buf + 16, ent->size);
+	putle64(buf + 24, ent->mtime);
+	putle64(buf + 32, ent->ctime);
+	memcpy(buf + 40, ent->sum, BLAKE3_OUT_LEN);
+	return fwrite(buf, 1, ENTRYLEN, file) == ENTRYLEN ? 0 : -1;
+}
+
+/* Merge the added entries into the cache file, dropping the loaded
+ * entries that cachekeep rejects. The new file replaces the old one
+ * atomically, so a concurrent reader sees one or the other, and keeps the
+ * old one's permissions. */
+static int
+cachesave(struct cache *c)
+{
+	struct stat st;
+	FILE *file;
+	char *tmp;
+	size_t i = 0, j = 0, kept = 0;
+	mode_t mode;
+	int fd, err = 0, cmp;
+
+	for (i = 0; i < c->len; i++)
+		kept += cachekeep(c, &c->ents[i]);
+	if (c->nadded == 0 && kept == c->len)
+		return 0;
+	i = 0;
+	if (stat(c->path, &st) == 0) {
+		mode = st.st_mode & 07777;
+	} else {
+		mode = umask(0);
+		umask(mode);
+		mode = 0666 & ~mode;
+	}
+	/* a stable order isn't needed: duplicates describe the same file */
+	qsort(c->added, c->nadded, sizeof(c->added[0]), entrycmp);
+	tmp = malloc(strlen(c->path) + 8);
+	if (!tmp) {
+		perror(argv0);
+		exit(1);
+	}
+	sprintf(tmp, "%s.XXXXXX", c->path);
+	fd = mkstemp(tmp);
+	if (fd < 0 || !(file = fdopen(fd, "wb"))) {
+		fprintf(stderr, "%s: create %s: %s\n", argv0, tmp, strerror(errno));
+		if (fd >= 0) {
+			close(fd);
+			unlink(tmp);
+		}
+		free(tmp);
+		return -1;
+	}
+	if (fchmod(fd, mode) != 0 || fwrite(CACHEMAGIC, 1, 8, file) != 8)
+		err = 1;
+	while (!err && (i < c->len || j < c->nadded)) {
+		if (i == c->len)
+			cmp = 1;
+		else if (j == c->nadded)
+			cmp = -1;
+		else
+			cmp = entrycmp(&c->ents[i], &c->added[j]);
+		if (cmp < 0) {
+			if (cachekeep(c, &c->ents[i]))
+				err = writeentry(file, &c->ents[i]);
+			i++;
+			continue;
+		}
+		/* an added entry replaces the loaded one for the same file */
+		if (cmp == 0)
+			i++;
+		while (j + 1 < c->nadded && entrycmp(&c->added[j], &c->added[j + 1]) == 0)
+			j++;
+		err = writeentry(file, &c->added[j++]);
+	}
+	if (fclose(file) != 0)
+		err = 1;
+	if (err || rename(tmp, c->path) != 0) {
+		fprintf(stderr, "%s: write %s: %s\n", argv0, c->path, strerror(errno));
+		unlink(tmp);
+		free(tmp);
+		return -1;
+	}
+	free(tmp);
+	return 0;
+}
+
+/* Hash the rest of a regular file through a memory map, so that the
+ * hasher sees the whole input in one call. Returns -1 if the file should
+ * be streamed instead, with ctx reset if it was used. A file that shrinks
+ * while mapped can't be detected in time for the pages past its new end,
+ * which raise SIGBUS. Any other change in size is caught afterwards, and
+ * the file is read again. */
+static int
+mapfile(FILE *file, blake3_hasher *ctx)
+{
+	struct stat st, after;
+	off_t off;
+	void *map;
+	int fd;
+
+	fd = fileno(file);
+	if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || (uintmax_t)st.st_size > SIZE_MAX)
+		return -1;
+	off = lseek(fd, 0, SEEK_CUR);
+	if (off < 0 || st.st_size - off < MAPMIN)
+		return -1;
+	map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (map == MAP_FAILED)
+		return -1;
+	posix_madvise(map, st.st_size, POSIX_MADV_SEQUENTIAL);
+	blake3_hasher_update(ctx, (char *)map + off, st.st_size - off);
+	munmap(map, st.st_size);
+	/* the file offset hasn't moved, so streaming starts over */
+	if (fstat(fd, &after) != 0 || after.st_size != st.st_size) {
+		blake3_hasher_reset(ctx);
+		return -1;
+	}
+	return 0;
+}
+
+#ifdef O_DIRECT
+/* Whether reads from fd bypass the page cache, and so must be aligned. */
+static int
+isdirect(int fd)
+{
+	int flags;
+
+	flags = fcntl(fd, F_GETFL);
+	return flags >= 0 && (flags & O_DIRECT);
+}
+
+/* Go back to reading through the page cache. */
+static int
+undirect(int fd)
+{
+	int flags;
+
+	flags = fcntl(fd, F_GETFL);
+	return flags < 0 ? -1 : fcntl(fd, F_SETFL, flags & ~O_DIRECT);
+}
+
+/* Open a file for -d. File systems without O_DIRECT support fail with
+ * EINVAL, and get a normal open instead. */
+static FILE *
+opendirect(const char *name, const char *mode)
+{
+	struct stat st;
+	FILE *file;
+	int fd, err;
+
+	fd = open(name, O_RDONLY | O_DIRECT);
+	if (fd < 0)
+		return errno == EINVAL ? fopen(name, mode) : NULL;
+	if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+		undirect(fd);
+	file = fdopen(fd, mode);
+	if (!file) {
+		err = errno;
+		close(fd);
+		errno = err;
+	}
+	return file;
+}
+
+/* Hash the rest of a file opened with O_DIRECT, without displacing
+ * anything in the page cache. If the file system rejects a read, such as
+ * the unaligned one that follows a short read at the end of the file, the
+ * rest is read through the page cache and dropped from it afterwards.
+ * Returns -1 with errno set on a read error. */
+static int
+directfile(FILE *file, blake3_hasher *ctx, struct reader *rd)
+{
+	off_t off, cached = -1;
+	ssize_t n;
+	void *buf;
+	int fd, err;
+
+	if (!rd->buf) {
+		err = posix_memalign(&buf, DIRECTALIGN, DIRECTBUF);
+		if (err) {
+			fprintf(stderr, "%s: %s\n", argv0, strerror(err));
+			exit(1);
+		}
+		rd->buf = buf;
+	}
+	fd = fileno(file);
+	off = lseek(fd, 0, SEEK_CUR);
+	if (off < 0)
+		return -1;
+	for (;;) {
+		n = pread(fd, rd->buf, DIRECTBUF, off);
+		if (n < 0) {
+			if (errno == EINTR)
+				continue;
+			if (errno != EINVAL || cached >= 0 || undirect(fd) != 0)
+				return -1;
+			cached = off;
+			continue;
+		}
+		if (n == 0)
+			break;
+		blake3_hasher_update(ctx, rd->buf, n);
+		off += n;
+	}
+	if (cached >= 0)
+		posix_fadvise(fd, cached, 0, POSIX_FADV_DONTNEED);
+	return 0;
+}
+#endif
+
+#ifdef WITH_URING
+/* Set up a ring, or return NULL if the kernel doesn't support it. */
+static struct uring *
+uringopen(void)
+{
+	struct io_uring_params p;
+	struct uring *r;
+	struct iovec iov;
+	void *buf;
+
+	r = calloc(1, sizeof(*r));
+	if (!r)
+		return NULL;
+	memset(&p, 0, sizeof(p));
+	r->fd = syscall(__NR_io_uring_setup, URINGDEPTH, &p);
+	if (r->fd < 0) {
+		free(r);
+		return NULL;
+	}
+	r->sqmaplen = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+	r->cqmaplen = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+	if (p.features & IORING_FEAT_SINGLE_MMAP) {
+		if (r->cqmaplen > r->sqmaplen)
+			r->sqmaplen = r->cqmaplen;
+		r->cqmaplen = 0;
+	}
+	r->sqeslen = p.sq_entries * sizeof(struct io_uring_sqe);
+	r->sqmap = r->cqmap = r->sqes = MAP_FAILED;
+	r->buf = NULL;
+	r->sqmap = mmap(NULL, r->sqmaplen, PROT_READ | PROT_WRITE, MAP_SHARED, r->fd, IORING_OFF_SQ_RING);
+	if (r->sqmap == MAP_FAILED)
+		goto fail;
+	r->cqmap = r->sqmap;
+	if (r->cqmaplen) {
+		r->cqmap = mmap(NULL, r->cqmaplen, PROT_READ | PROT_WRITE, MAP_SHARED, r->fd, IORING_OFF_CQ_RING);
+		if (r->cqmap == MAP_FAILED)
+			goto fail;
+	}
+	r->sqes = mmap(NULL, r->sqeslen, PROT_READ | PROT_WRITE, MAP_SHARED, r->fd, IORING_OFF_SQES);
+	if (r->sqes == MAP_FAILED)
+		goto fail;
+	if (posix_memalign(&buf, 4096, URINGDEPTH * URINGBUF) != 0)
+		goto fail;
+	r->buf = buf;
+	/* registered buffers are pinned once rather than on every read, but
+	 * count against RLIMIT_MEMLOCK, so plain reads are the fallback */
+	iov.iov_base = r->buf;
+	iov.iov_len = URINGDEPTH * URINGBUF;
+	r->fixed = syscall(__NR_io_uring_register, r->fd, IORING_REGISTER_BUFFERS, &iov, 1) == 0;
+	r->sqhead = (unsigned *)((char *)r->sqmap + p.sq_off.head);
+	r->sqtail = (unsigned *)((char *)r->sqmap + p.sq_off.tail);
+	r->sqmask = (unsigned *)((char *)r->sqmap + p.sq_off.ring_mask);
+	r->sqarray = (unsigned *)((char *)r->sqmap + p.sq_off.array);
+	r->cqhead = (unsigned *)((char *)r->cqmap + p.cq_off.head);
+	r->cqtail = (unsigned *)((char *)r->cqmap + p.cq_off.tail);
+	r->cqmask = (unsigned *)((char *)r->cqmap + p.cq_off.ring_mask);
+	r->cqes = (struct io_uring_cqe *)((char *)r->cqmap + p.cq_off.cqes);
+	return r;
+
+fail:
+	uringclose(r);
+	return NULL;
+}
+
+static void
+uringclose(struct uring *r)
+{
+	if (!r)
+		return;
+	if (r->sqes != MAP_FAILED)
+		munmap(r->sqes, r->sqeslen);
+	if (r->cqmap != MAP_FAILED && r->cqmap != r->sqmap)
+		munmap(r->cqmap, r->cqmaplen);
+	if (r->sqmap != MAP_FAILED)
+		munmap(r->sqmap, r->sqmaplen);
+	close(r->fd);
+	free(r->buf);
+	free(r);
+}
+
+/* Queue a read into a slot's buffer. It is submitted by the next call to
+ * uringwait. */
+static void
+uringread(struct uring *r, int slot, int fd, off_t off, size_t len)
+{
+	struct io_uring_sqe *sqe;
+	unsigned tail, idx;
+
+	tail = *r->sqtail;
+	idx = tail & *r->sqmask;
+	sqe = &r->sqes[idx];
+	memset(sqe, 0, sizeof(*sqe));
+	sqe->opcode = r->fixed ? IORING_OP_READ_FIXED : IORING_OP_READ;
+	sqe->fd = fd;
+	sqe->off = off;
+	sqe->addr = (uintptr_t)(r->buf + (size_t)slot * URINGBUF);
+	sqe->len = len;
+	sqe->user_data = slot;
+	r->sqarray[idx] = idx;
+	__atomic_store_n(r->sqtail, tail + 1, __ATOMIC_RELEASE);
+	r->pending++;
+	r->off[slot] = off;
+	r->len[slot] = len;
+}
+
+/* Submit any queued reads and wait for a slot's read to finish. Returns
+ * its result: the number of bytes read, or a negated errno. */
+static int
+uringwait(struct uring *r, int slot)
+{
+	struct io_uring_cqe *cqe;
+	unsigned head, tail;
+	long n;
+
+	for (;;) {
+		head = *r->cqhead;
+		tail = __atomic_load_n(r->cqtail, __ATOMIC_ACQUIRE);
+		for (; head != tail; head++) {
+			cqe = &r->cqes[head & *r->cqmask];
+			r->res[cqe->user_data] = cqe->res;
+			r->done[cqe->user_data] = 1;
+		}
+		__atomic_store_n(r->cqhead, head, __ATOMIC_RELEASE);
+		if (r->done[slot])
+			break;
+		n = syscall(__NR_io_uring_enter, r->fd, r->pending, 1, IORING_ENTER_GETEVENTS, NULL, 0);
+		if (n < 0) {
+			if (errno == EINTR || errno == EAGAIN || errno == EBUSY)
+				continue;
+			fprintf(stderr, "%s: io_uring_enter: %s\n", argv0, strerror(errno));
+			exit(1);
+		}
+		r->pending -= n;
+	}
+	r->done[slot] = 0;
+	return r->res[slot];
+}
+
+/* Hash the rest of a regular file with several reads in flight, hashing
+ * each buffer while the following ones load. Returns 1 if the file should
+ * be read some other way, or -1 with errno set on a read error. */
 static int
-sumfile(const char *name, FILE *file, unsigned char *out, size_t outlen)
+uringfile(struct uring *r, FILE *file, blake3_hasher *ctx)
+{
+	struct stat st;
+	unsigned long queued = 0, hashed = 0;
+	off_t next, end, cached = -1;
+	size_t len;
+	int fd, slot, res, odirect = 0, err = 0;
+
+	fd = fileno(file);
+	if (!r || fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+		return 1;
+	next = lseek(fd, 0, SEEK_CUR);
+	end = st.st_size;
+	if (next < 0 || end - next < MAPMIN)
+		return 1;
+#ifdef O_DIRECT
+	odirect = isdirect(fd);
+#endif
+	for (;;) {
+		while (queued - hashed < URINGDEPTH && next < end) {
+			len = end - next < URINGBUF ? (size_t)(end - next) : URINGBUF;
+			/* a direct read of the tail is rounded up, and comes
+			 * back short */
+			if (odirect)
+				len = (len + DIRECTALIGN - 1) & ~(size_t)(DIRECTALIGN - 1);
+			uringread(r, queued++ % URINGDEPTH, fd, next, len);
+			next += len;
+		}
+		if (hashed == queued)
+			break;
+		slot = hashed++ % URINGDEPTH;
+		res = uringwait(r, slot);
+#ifdef O_DIRECT
+		if (res == -EINVAL && odirect) {
+			/* the file system wants some other alignment, so
+			 * carry on through the page cache */
+			while (hashed < queued)
+				uringwait(r, hashed++ % URINGDEPTH);
+			if (undirect(fd) != 0) {
+				err = errno;
+				break;
+			}
+			odirect = 0;
+			cached = next = r->off[slot];
+			continue;
+		}
+#endif
+		if (res < 0) {
+			err = -res;
+			break;
+		}
+		blake3_hasher_update(ctx, r->buf + (size_t)slot * URINGBUF, res);
+		if ((size_t)res < r->len[slot]) {
+			/* the reads queued after a short one are at the wrong
+			 * offsets, so drop them and carry on from here */
+			while (hashed < queued)
+				uringwait(r, hashed++ % URINGDEPTH);
+			if (res == 0)
+				break;
+			next = r->off[slot] + res;
+		}
+	}
+	while (hashed < queued)
+		uringwait(r, hashed++ % URINGDEPTH);
+	if (cached >= 0)
+		posix_fadvise(fd, cached, 0, POSIX_FADV_DONTNEED);
+	if (err) {
+		errno = err;
+		return -1;
+	}
+	return 0;
+}
+#endif
+
+static void
+readerinit(struct reader *rd)
+{
+	rd->ring = uringopen();
+	rd->buf = NULL;
+}
+
+static void
+readerfree(struct reader *rd)
+{
+	uringclose(rd->ring);
+	free(rd->buf);
+	rd->ring = NULL;
+	rd->buf = NULL;
+}
+
+/* Returns -1 with errno set on a read error. */
+static int
+sumfile(FILE *file, unsigned char *out, size_t outlen, struct reader *rd)
 {
 	char buf[16384];
 	blake3_hasher ctx;
 	size_t len;
 
 	blake3_hasher_init(&ctx);
+#ifdef WITH_URING
+	switch (uringfile(rd->ring, file, &ctx)) {
+	case 0:
+		blake3_hasher_finalize(&ctx, out, outlen);
+		return 0;
+	case -1:
+		return -1;
+	}
+#endif
+#ifdef O_DIRECT
+	if (isdirect(fileno(file))) {
+		if (directfile(file, &ctx, rd) != 0)
+			return -1;
+		blake3_hasher_finalize(&ctx, out, outlen);
+		return 0;
+	}
+#endif
+	if (mapfile(file, &ctx) == 0) {
+		blake3_hasher_finalize(&ctx, out, outlen);
+		return 0;
+	}
 	do {
 		len = fread(buf, 1, sizeof(buf), file);
 		if (len > 0)
 			blake3_hasher_update(&ctx, buf, len);
 	} while (len == sizeof(buf));
-	if (ferror(file)) {
-		fprintf(stderr, "%s: read %s: ", argv0, name);
-		perror(NULL);
-		return 1;
-	}
+	if (ferror(file))
+		return -1;
 	blake3_hasher_finalize(&ctx, out, outlen);
 	return 0;
 }
 
+/* Whether a file may have been written within the timestamp granularity
+ * before start, so that a write made after it was read could leave its
+ * metadata unchanged. Like git's racily clean index entries, such a file
+ * isn't cached. */
 static int
-sum(const char *name, FILE *file)
+racy(const struct entry *ent, const struct timespec *start)
+{
+	uint64_t now, gran;
+
+	now = (uint64_t)start->tv_sec * 1000000000 + start->tv_nsec;
+	gran = ent->mtime % 1000000000 == 0 && ent->ctime % 1000000000 == 0 ? RACYCOARSE : RACYFINE;
+	return ent->mtime + gran >= now || ent->ctime + gran >= now;
+}
+
+/* Like sumfile, but look up regular files in the cache first, and record
+ * the digest of a file that misses so that it can be added. */
+static int
+cachedsum(FILE *file, struct job *job, struct reader *rd)
+{
+	struct entry *ent, after;
+	struct timespec start;
+	struct stat st;
+	int fd;
+
+	fd = fileno(file);
+	if (!cache.path || job->outlen > BLAKE3_OUT_LEN || fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || lseek(fd, 0, SEEK_CUR) != 0)
+		return sumfile(file, job->out, job->outlen, rd);
+	statentry(&st, &job->ent);
+	ent = cachefind(&cache, &job->ent);
+	if (ent && samefile(ent, &job->ent)) {
+		memcpy(job->out, ent->sum, job->outlen);
+		job->hit = ent;
+		return 0;
+	}
+	job->old = ent;
+	if (clock_gettime(CLOCK_REALTIME, &start) != 0)
+		return sumfile(file, job->out, job->outlen, rd);
+	/* shorter outputs are prefixes of the default-length one */
+	if (sumfile(file, job->ent.sum, BLAKE3_OUT_LEN, rd) != 0)
+		return -1;
+	memcpy(job->out, job->ent.sum, job->outlen);
+	/* don't cache a file that changed while it was read, or that might
+	 * yet change without its metadata showing it */
+	if (fstat(fd, &st) == 0) {
+		statentry(&st, &after);
+		job->store = samefile(&after, &job->ent) && !racy(&job->ent, &start);
+	}
+	return 0;
+}
+
+static void
+runjob(struct job *job, struct reader *rd)
+{
+	FILE *file;
+
+	if (job->skip)
+		return;
+	file = job->file;
+	if (!file) {
+#ifdef O_DIRECT
+		file = direct ? opendirect(job->name, job->mode) : fopen(job->name, job->mode);
+#else
+		file = fopen(job->name, job->mode);
+#endif
+		if (!file) {
+			job->op = "open";
+			job->err = errno;
+			return;
+		}
+	}
+	if (cachedsum(file, job, rd) != 0) {
+		job->op = "read";
+		job->err = errno;
+	}
+	if (!job->file)
+		fclose(file);
+}
+
+/* Allocate a job with room for an outlen-byte checksum followed by extra
+ * bytes of storage owned by the job. */
+static struct job *
+newjob(int (*report)(struct job *), const char *name, FILE *file, const char *mode, size_t outlen, size_t extra)
+{
+	struct job *job;
+
+	job = malloc(sizeof(*job) + outlen + extra);
+	if (!job) {
+		perror(argv0);
+		exit(1);
+	}
+	job->report = report;
+	job->name = name;
+	job->file = file;
+	job->mode = mode;
+	job->skip = NULL;
+	job->op = NULL;
+	job->err = 0;
+	job->done = 0;
+	job->outlen = outlen;
+	job->store = 0;
+	job->hit = NULL;
+	job->old = NULL;
+	job->sum = NULL;
+	return job;
+}
+
+static int
+reportjob(struct job *job)
+{
+	int ret;
+
+	if (job->skip) {
+		fprintf(stderr, "%s: skipping %s\n", argv0, job->skip);
+		ret = 1;
+	} else if (job->op) {
+		fprintf(stderr, "%s: %s %s: %s\n", argv0, job->op, job->name, strerror(job->err));
+		ret = 1;
+	} else {
+		if (job->store)
+			cacheadd(&cache, &job->ent);
+		if (job->hit)
+			job->hit->used = 1;
+		if (job->old)
+			job->old->stale = 1;
+		ret = job->report(job);
+	}
+	free(job);
+	return ret;
+}
+
+#ifdef WITH_THREADS
+static void *
+worker(void *arg)
+{
+	struct pool *p = arg;
+	struct reader rd;
+	struct job *job;
+
+	readerinit(&rd);
+	pthread_mutex_lock(&p->lock);
+	for (;;) {
+		while (p->next == p->tail && !p->closed)
+			pthread_cond_wait(&p->queued, &p->lock);
+		if (p->next == p->tail)
+			break;
+		job = p->jobs[p->next++ % p->size];
+		pthread_mutex_unlock(&p->lock);
+		runjob(job, &rd);
+		pthread_mutex_lock(&p->lock);
+		job->done = 1;
+		pthread_cond_signal(&p->finished);
+	}
+	pthread_mutex_unlock(&p->lock);
+	readerfree(&rd);
+	return NULL;
+}
+
+/* Report the oldest queued job, waiting for it to finish if wait is set.
+ * Returns -1 if there is nothing to report. Called with the lock held. */
+static int
+reporthead(struct pool *p, int wait)
+{
+	struct job *job;
+	int ret;
+
+	if (p->head == p->tail)
+		return -1;
+	job = p->jobs[p->head % p->size];
+	while (!job->done) {
+		if (!wait)
+			return -1;
+		pthread_cond_wait(&p->finished, &p->lock);
+	}
+	p->head++;
+	pthread_mutex_unlock(&p->lock);
+	ret = reportjob(job);
+	pthread_mutex_lock(&p->lock);
+	return ret;
+}
+#endif
+
+static void
+poolinit(struct pool *p, size_t nthreads)
 {
+#ifdef WITH_THREADS
 	size_t i;
+	int err;
 
-	if (sumfile(name, file, out, outlen) != 0)
-		return 1;
-	for (i = 0; i < outlen; i++)
-		printf("%02x", out[i]);
-	printf("  %s\n", name);
+	p->head = p->next = p->tail = 0;
+	p->closed = 0;
+	p->nthreads = 0;
+	p->reader.ring = NULL;
+	p->reader.buf = NULL;
+	if (nthreads <= 1) {
+		readerinit(&p->reader);
+		return;
+	}
+	p->size = nthreads * WINDOW;
+	p->jobs = calloc(p->size, sizeof(p->jobs[0]));
+	p->threads = calloc(nthreads, sizeof(p->threads[0]));
+	if (!p->jobs || !p->threads) {
+		perror(argv0);
+		exit(1);
+	}
+	pthread_mutex_init(&p->lock, NULL);
+	pthread_cond_init(&p->queued, NULL);
+	pthread_cond_init(&p->finished, NULL);
+	for (i = 0; i < nthreads; i++) {
+		err = pthread_create(&p->threads[i], NULL, worker, p);
+		if (err) {
+			fprintf(stderr, "%s: pthread_create: %s\n", argv0, strerror(err));
+			exit(1);
+		}
+		p->nthreads++;
+	}
+#else
+	(void)nthreads;
+	readerinit(&p->reader);
+#endif
+}
+
+/* Queue a job, reporting any earlier jobs that have finished. Without
+ * worker threads, the job is run and reported immediately. */
+static int
+pooladd(struct pool *p, struct job *job)
+{
+#ifdef WITH_THREADS
+	int ret = 0, r;
+
+	if (p->nthreads > 0) {
+		pthread_mutex_lock(&p->lock);
+		while (p->tail - p->head == p->size)
+			ret |= reporthead(p, 1);
+		p->jobs[p->tail++ % p->size] = job;
+		pthread_cond_signal(&p->queued);
+		while ((r = reporthead(p, 0)) != -1)
+			ret |= r;
+		pthread_mutex_unlock(&p->lock);
+		return ret;
+	}
+#else
+	(void)p;
+#endif
+	runjob(job, &p->reader);
+	return reportjob(job);
+}
+
+/* Report all queued jobs. */
+static int
+poolwait(struct pool *p)
+{
+#ifdef WITH_THREADS
+	int ret = 0, r;
+
+	if (p->nthreads == 0)
+		return 0;
+	pthread_mutex_lock(&p->lock);
+	while ((r = reporthead(p, 1)) != -1)
+		ret |= r;
+	pthread_mutex_unlock(&p->lock);
+	return ret;
+#else
+	(void)p;
+	return 0;
+#endif
+}
+
+/* Report all remaining jobs and stop the workers. */
+static int
+pooldrain(struct pool *p)
+{
+#ifdef WITH_THREADS
+	size_t i;
+	int ret;
+#endif
+
+	readerfree(&p->reader);
+#ifdef WITH_THREADS
+	if (p->nthreads == 0)
+		return 0;
+	ret = poolwait(p);
+	pthread_mutex_lock(&p->lock);
+	p->closed = 1;
+	pthread_cond_broadcast(&p->queued);
+	pthread_mutex_unlock(&p->lock);
+	for (i = 0; i < p->nthreads; i++)
+		pthread_join(p->threads[i], NULL);
+	free(p->threads);
+	free(p->jobs);
+	p->nthreads = 0;
+	return ret;
+#else
+	return 0;
+#endif
+}
+
+static int
+printsum(struct job *job)
+{
+	size_t i;
+
+	for (i = 0; i < job->outlen; i++)
+		printf("%02x", job->out[i]);
+	printf("  %s\n", job->name);
 	return 0;
 }
 
+static int
+sum(const char *name, FILE *file)
+{
+	return pooladd(&pool, newjob(printsum, name, file, NULL, outlen, 0));
+}
+
+/* Queue a file to be opened by a worker, with a copy of its name. */
+static int
+sumpath(const char *name, const char *mode)
+{
+	struct job *job;
+
+	job = newjob(printsum, NULL, NULL, mode, outlen, strlen(name) + 1);
+	job->name = strcpy((char *)job->out + outlen, name);
+	return pooladd(&pool, job);
+}
+
+/* A directory entry read by walk, with the result of its stat. */
+struct dent {
+	char *name;
+	mode_t mode;
+	int err;
+};
+
+static int
+dentcmp(const void *a, const void *b)
+{
+	return strcmp(((const struct dent *)a)->name, ((const struct dent *)b)->name);
+}
+
+/* Open the directory name, relative to fd, without following a symbolic
+ * link unless follow is set. */
+static DIR *
+opendirat(int fd, const char *name, int follow)
+{
+	DIR *dir;
+	int dfd, err;
+
+	dfd = openat(fd, name, O_RDONLY | O_DIRECTORY | (follow ? 0 : O_NOFOLLOW));
+	if (dfd < 0)
+		return NULL;
+	dir = fdopendir(dfd);
+	if (!dir) {
+		err = errno;
+		close(dfd);
+		errno = err;
+	}
+	return dir;
+}
+
+/* Queue a job for each regular file below the directory name, relative to
+ * fd, whose path for output and for the workers is path. Entries are sorted
+ * by name so that the output doesn't depend on the order of directory
+ * entries, and symbolic links and special files are skipped.
+ * Subdirectories are opened relative to their parent, so that a directory
+ * renamed or replaced by a link during the walk can't redirect it. Each
+ * level holds its directory open for that, up to walkfds levels; below
+ * them, a directory is closed before descending into it, and its
+ * subdirectories are opened by path. */
+static int
+walk(int fd, const char *name, const char *path, const char *mode, size_t held)
+{
+	struct dirent *d;
+	struct stat st;
+	DIR *dir;
+	struct dent *ents = NULL, *tmp;
+	char *sub;
+	size_t len = 0, cap = 0, pathlen, i;
+	int ret = 0;
+
+	/* only the directories given as arguments may be links */
+	dir = opendirat(fd, name, held == 0);
+	if (!dir) {
+		fprintf(stderr, "%s: open %s: %s\n", argv0, path, strerror(errno));
+		return 1;
+	}
+	for (;;) {
+		errno = 0;
+		d = readdir(dir);
+		if (!d)
+			break;
+		if (strcmp(d->d_name, ".") == 0 || strcmp(d->d_name, "..") == 0)
+			continue;
+		if (len == cap) {
+			cap = cap ? cap * 2 : 64;
+			tmp = realloc(ents, cap * sizeof(ents[0]));
+			if (!tmp) {
+				perror(argv0);
+				exit(1);
+			}
+			ents = tmp;
+		}
+		ents[len].name = strdup(d->d_name);
+		if (!ents[len].name) {
+			perror(argv0);
+			exit(1);
+		}
+		len++;
+	}
+	if (errno) {
+		fprintf(stderr, "%s: read %s: %s\n", argv0, path, strerror(errno));
+		ret = 1;
+	}
+	for (i = 0; i < len; i++) {
+		ents[i].err = 0;
+		if (fstatat(dirfd(dir), ents[i].name, &st, AT_SYMLINK_NOFOLLOW) == 0)
+			ents[i].mode = st.st_mode;
+		else
+			ents[i].err = errno;
+	}
+	if (held >= walkfds) {
+		closedir(dir);
+		dir = NULL;
+	}
+	qsort(ents, len, sizeof(ents[0]), dentcmp);
+	pathlen = strlen(path);
+	for (i = 0; i < len; i++) {
+		sub = malloc(pathlen + strlen(ents[i].name) + 2);
+		if (!sub) {
+			perror(argv0);
+			exit(1);
+		}
+		sprintf(sub, "%s%s%s", path, pathlen > 0 && path[pathlen - 1] == '/' ? "" : "/", ents[i].name);
+		if (ents[i].err) {
+			fprintf(stderr, "%s: stat %s: %s\n", argv0, sub, strerror(ents[i].err));
+			ret = 1;
+		} else if (S_ISDIR(ents[i].mode)) {
+			if (dir)
+				ret |= walk(dirfd(dir), ents[i].name, sub, mode, held + 1);
+			else
+				ret |= walk(AT_FDCWD, sub, sub, mode, held);
+		} else if (S_ISREG(ents[i].mode)) {
+			ret |= sumpath(sub, mode);
+		}
+		free(sub);
+		free(ents[i].name);
+	}
+	if (dir)
+		closedir(dir);
+	free(ents);
+	return ret;
+}
+
 static int
 hexval(int c)
 {
@@ -64,80 +1241,79 @@ hexval(int c)
 }
 
 static int
-checkfile(const char *name, const char *mode, const char *str, unsigned char *out, size_t len)
+printcheck(struct job *job)
 {
-	FILE *file;
-	int c1, c2;
-	size_t i;
-
-	file = fopen(name, mode);
-	if (!file) {
-		fprintf(stderr, "%s: open %s: ", argv0, name);
-		perror(NULL);
+	if (memcmp(job->out, job->sum, job->outlen) != 0) {
+		printf("%s: FAILED\n", job->name);
 		return 1;
 	}
-	sumfile(name, file, out, len);
-	for (i = 0; i < len; i++) {
-		c1 = hexval(str[i * 2]);
-		c2 = hexval(str[i * 2 + 1]);
-		if (c1 == -1 || c2 == -2) {
-			fprintf(stderr, "%s: skipping invalid checksum line\n", argv0);
-			return 1;
-		}
-		if (out[i] != (c1 << 4 | c2)) {
-			printf("%s: FAILED\n", name);
-			return 1;
-		}
-	}
-	printf("%s: OK\n", name);
+	printf("%s: OK\n", job->name);
 	return 0;
 }
 
+static int
+skipline(const char *reason)
+{
+	struct job *job;
+
+	job = newjob(NULL, NULL, NULL, NULL, 0, 0);
+	job->skip = reason;
+	return pooladd(&pool, job);
+}
+
+/* Queue a job for each line of a checklist. Lines that can't be checked
+ * are queued too, so that every message is reported in line order. */
 static int
 check(const char *name, FILE *file)
 {
+	struct job *job;
 	const char *mode;
 	char buf[8192], *pos, *end;
-	size_t len;
-	int ret = 0, skip = 0;
+	size_t i, len;
+	int c1, c2, ret = 0, skip = 0, partial;
 
 	buf[sizeof(buf) - 2] = 0;
 	while (fgets(buf, sizeof(buf), file)) {
-		if (buf[sizeof(buf) - 2]) {
-			fprintf(stderr, "%s: skipping line that is too long\n", argv0);
-			buf[sizeof(buf) - 2] = 0;
-			skip = 1;
-			ret = 1;
+		/* a full buffer that doesn't end the line */
+		partial = buf[sizeof(buf) - 2] && buf[sizeof(buf) - 2] != '\n';
+		buf[sizeof(buf) - 2] = 0;
+		if (skip) {
+			/* the rest of a line that is too long */
+			skip = partial;
 			continue;
 		}
-		if (skip) {
-			skip = 0;
+		if (partial) {
+			ret |= skipline("line that is too long");
+			skip = 1;
 			continue;
 		}
 		pos = strchr(buf, ' ');
 		if (!pos || pos == buf || (pos[1] != ' ' && pos[1] != '*') || (pos - buf) & 1) {
-			fprintf(stderr, "%s: skipping invalid checksum line\n", argv0);
-			ret = 1;
+			ret |= skipline("invalid checksum line");
 			continue;
 		}
 		mode = pos[1] == ' ' ? "r" : "rb";
 		len = (pos - buf) / 2;
-		if (len > outlen) {
-			outlen = len;
-			free(out);
-			out = malloc(len);
-			if (!out) {
-				perror(argv0);
-				return 1;
-			}
-		}
 		*pos = '\0';
 		pos += 2;
 		end = strchr(pos, '\n');
 		if (end)
 			*end = '\0';
-		ret |= checkfile(pos, mode, buf, out, len);
+		job = newjob(printcheck, NULL, NULL, mode, len, len + strlen(pos) + 1);
+		job->sum = job->out + len;
+		job->name = strcpy((char *)job->sum + len, pos);
+		for (i = 0; i < len; i++) {
+			c1 = hexval(buf[i * 2]);
+			c2 = hexval(buf[i * 2 + 1]);
+			if (c1 == -1 || c2 == -1) {
+				job->skip = "invalid checksum line";
+				break;
+			}
+			job->sum[i] = c1 << 4 | c2;
+		}
+		ret |= pooladd(&pool, job);
 	}
+	ret |= poolwait(&pool);
 	if (ferror(file)) {
 		fprintf(stderr, "%s: read %s: ", argv0, name);
 		perror(NULL);
@@ -150,10 +1326,13 @@ int
 main(int argc, char *argv[])
 {
 	int (*func)(const char *, FILE *) = sum;
+	struct stat st;
 	FILE *file;
 	char *end;
 	const char *name, *mode = NULL;
-	int ret = 0;
+	size_t nthreads = 1;
+	struct rlimit rl;
+	int ret = 0, recurse = 0;
 
 	argv0 = argc ? argv[0] : "b3sum";
 	ARGBEGIN {
@@ -163,11 +1342,28 @@ main(int argc, char *argv[])
 	case 'c':
 		func = check;
 		break;
+	case 'd':
+		direct = 1;
+		break;
+	case 'C':
+		cacheload(&cache, EARGF(usage()));
+		break;
+	case 'j':
+		nthreads = strtoul(EARGF(usage()), &end, 10);
+		if (*end || nthreads == 0)
+			usage();
+		break;
 	case 'l':
 		outlen = strtoul(EARGF(usage()), &end, 10);
 		if (*end)
 			usage();
 		break;
+	case 'p':
+		cache.prune = 1;
+		break;
+	case 'r':
+		recurse = 1;
+		break;
 	case 't':
 		mode = "r";
 		break;
@@ -175,11 +1371,13 @@ main(int argc, char *argv[])
 		usage();
 	} ARGEND
 
-	out = malloc(outlen);
-	if (!out) {
-		perror(NULL);
-		return 1;
-	}
+	if (recurse && func == check)
+		usage();
+	/* leave most file descriptors to the files being hashed */
+	if (recurse && getrlimit(RLIMIT_NOFILE, &rl) == 0 && rl.rlim_cur / 4 > 1)
+		walkfds = rl.rlim_cur == RLIM_INFINITY || rl.rlim_cur / 4 > WALKFDS ? WALKFDS : rl.rlim_cur / 4;
+
+	poolinit(&pool, nthreads);
 
 	if (argc == 0) {
 		if (!mode || strcmp(mode, "r") == 0 || freopen(NULL, mode, stdin)) {
@@ -194,6 +1392,15 @@ main(int argc, char *argv[])
 			mode = "r";
 		for (; argc > 0; argc--, argv++) {
 			name = *argv;
+			if (func == sum) {
+				if (recurse && stat(name, &st) == 0 && S_ISDIR(st.st_mode)) {
+					ret |= walk(AT_FDCWD, name, name, mode, 0);
+					continue;
+				}
+				/* the workers open the files themselves */
+				ret |= pooladd(&pool, newjob(printsum, name, NULL, mode, outlen, 0));
+				continue;
+			}
 			file = fopen(name, mode);
 			if (file) {
 				ret |= func(name, file);
@@ -205,6 +1412,9 @@ main(int argc, char *argv[])
 			}
 		}
 	}
+	ret |= pooldrain(&pool);
+	if (cache.path && cachesave(&cache) != 0)
+		ret = 1;
 
 	return ret;
 }
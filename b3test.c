@@ -0,0 +1,670 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef WITH_THREADS
+#include <pthread.h>
+#endif
+
+#include "blake3.h"
+
+/* the length of each extended output in test_vectors.json */
+#define XOFLEN 131
+#define MAXCASES 64
+/* the shortest subtree whose halves are handed to an executor */
+#define SPLITLEN (2048 * BLAKE3_CHUNK_LEN)
+
+struct vector {
+	size_t len;
+	unsigned char *input;
+	char hash[2 * XOFLEN + 1];
+	char keyed[2 * XOFLEN + 1];
+	char derive[2 * XOFLEN + 1];
+};
+
+static const char *argv0;
+static const char *backend;
+static char context[128];
+static unsigned char key[BLAKE3_KEY_LEN];
+static struct vector vecs[MAXCASES];
+static size_t nvecs;
+static int failed;
+
+static void
+fail(const char *what, size_t len)
+{
+	fprintf(stderr, "%s: %s(%zu) failed with backend %s\n", argv0, what, len, backend);
+	failed = 1;
+}
+
+static void
+check(int ok, const char *what, size_t len)
+{
+	if (!ok)
+		fail(what, len);
+}
+
+static void
+tohex(const unsigned char *buf, size_t len, char *hex)
+{
+	static const char digits[] = "0123456789abcdef";
+	size_t i;
+
+	for (i = 0; i < len; i++) {
+		hex[2 * i] = digits[buf[i] >> 4];
+		hex[2 * i + 1] = digits[buf[i] & 0xf];
+	}
+	hex[2 * len] = '\0';
+}
+
+/* Copy the JSON string value following name, at or after pos, into out.
+ * Returns the position after the value, or NULL if there is none. */
+static const char *
+field(const char *pos, const char *name, char *out, size_t outlen)
+{
+	const char *end;
+
+	pos = strstr(pos, name);
+	if (!pos)
+		return NULL;
+	pos = strchr(pos + strlen(name), ':');
+	if (!pos || !(pos = strchr(pos, '"')) || !(end = strchr(++pos, '"')))
+		return NULL;
+	if ((size_t)(end - pos) >= outlen)
+		return NULL;
+	memcpy(out, pos, end - pos);
+	out[end - pos] = '\0';
+	return end + 1;
+}
+
+static int
+load(const char *path)
+{
+	FILE *file;
+	char *json, *pos, buf[64];
+	const char *p;
+	size_t len, i;
+	long size;
+
+	file = fopen(path, "r");
+	if (!file) {
+		perror(path);
+		return -1;
+	}
+	if (fseek(file, 0, SEEK_END) != 0 || (size = ftell(file)) < 0 || fseek(file, 0, SEEK_SET) != 0) {
+		perror(path);
+		fclose(file);
+		return -1;
+	}
+	json = malloc(size + 1);
+	if (!json || fread(json, 1, size, file) != (size_t)size) {
+		fprintf(stderr, "%s: read %s failed\n", argv0, path);
+		fclose(file);
+		return -1;
+	}
+	fclose(file);
+	json[size] = '\0';
+
+	if (!field(json, "\"key\"", buf, sizeof(buf)) || strlen(buf) != BLAKE3_KEY_LEN)
+		goto bad;
+	memcpy(key, buf, BLAKE3_KEY_LEN);
+	if (!field(json, "\"context_string\"", context, sizeof(context)))
+		goto bad;
+	for (pos = json; (pos = strstr(pos, "\"input_len\"")); nvecs++) {
+		if (nvecs == MAXCASES)
+			goto bad;
+		pos = strchr(pos, ':');
+		if (!pos)
+			goto bad;
+		len = strtoul(pos + 1, &pos, 10);
+		vecs[nvecs].len = len;
+		vecs[nvecs].input = malloc(len ? len : 1);
+		if (!vecs[nvecs].input)
+			goto bad;
+		/* the same repeating pattern as test.py */
+		for (i = 0; i < len; i++)
+			vecs[nvecs].input[i] = i % 251;
+		if (!(p = field(pos, "\"hash\"", vecs[nvecs].hash, sizeof(vecs[nvecs].hash))) ||
+		    !(p = field(p, "\"keyed_hash\"", vecs[nvecs].keyed, sizeof(vecs[nvecs].keyed))) ||
+		    !(p = field(p, "\"derive_key\"", vecs[nvecs].derive, sizeof(vecs[nvecs].derive))))
+			goto bad;
+		pos = (char *)p;
+	}
+	free(json);
+	return nvecs ? 0 : -1;
+
+bad:
+	fprintf(stderr, "%s: %s: unexpected format\n", argv0, path);
+	free(json);
+	return -1;
+}
+
+/* the reference: a hasher fed the whole input at once */
+static void
+reference(const struct vector *v, int mode, unsigned char *out, size_t outlen)
+{
+	blake3_hasher hasher;
+
+	if (mode == 1)
+		blake3_hasher_init_keyed(&hasher, key);
+	else if (mode == 2)
+		blake3_hasher_init_derive_key(&hasher, context);
+	else
+		blake3_hasher_init(&hasher);
+	blake3_hasher_update(&hasher, v->input, v->len);
+	blake3_hasher_finalize(&hasher, out, outlen);
+}
+
+static void
+testhasher(const struct vector *v)
+{
+	const char *expect[] = {v->hash, v->keyed, v->derive};
+	unsigned char out[XOFLEN];
+	char hex[2 * XOFLEN + 1];
+	int mode;
+
+	for (mode = 0; mode < 3; mode++) {
+		reference(v, mode, out, sizeof(out));
+		tohex(out, sizeof(out), hex);
+		check(strcmp(hex, expect[mode]) == 0, "blake3_hasher", v->len);
+	}
+}
+
+static void
+testoneshot(const struct vector *v)
+{
+	unsigned char want[XOFLEN], out[XOFLEN];
+	blake3_prepared_key prepared;
+
+	reference(v, 0, want, sizeof(want));
+	blake3_hash(v->input, v->len, out, sizeof(out));
+	check(memcmp(out, want, sizeof(out)) == 0, "blake3_hash", v->len);
+
+	reference(v, 1, want, sizeof(want));
+	blake3_hash_keyed(key, v->input, v->len, out, sizeof(out));
+	check(memcmp(out, want, sizeof(out)) == 0, "blake3_hash_keyed", v->len);
+	blake3_prepared_key_init_keyed(&prepared, key);
+	blake3_hash_prepared(&prepared, v->input, v->len, out, sizeof(out));
+	check(memcmp(out, want, sizeof(out)) == 0, "blake3_hash_prepared keyed", v->len);
+
+	reference(v, 2, want, sizeof(want));
+	blake3_hash_derive_key(context, v->input, v->len, out, sizeof(out));
+	check(memcmp(out, want, sizeof(out)) == 0, "blake3_hash_derive_key", v->len);
+	blake3_prepared_key_init_derive_key(&prepared, context);
+	blake3_hash_prepared(&prepared, v->input, v->len, out, sizeof(out));
+	check(memcmp(out, want, sizeof(out)) == 0, "blake3_hash_prepared derive_key", v->len);
+}
+
+static void
+testprepared(const struct vector *v)
+{
+	unsigned char want[XOFLEN], out[XOFLEN];
+	blake3_prepared_key prepared;
+	blake3_hasher hasher;
+	blake3_compact_hasher compact;
+
+	reference(v, 1, want, sizeof(want));
+	blake3_prepared_key_init_keyed(&prepared, key);
+	blake3_hasher_init_prepared(&hasher, &prepared);
+	blake3_hasher_update(&hasher, v->input, v->len);
+	blake3_hasher_finalize(&hasher, out, sizeof(out));
+	check(memcmp(out, want, sizeof(out)) == 0, "blake3_hasher_init_prepared keyed", v->len);
+	blake3_compact_hasher_init_prepared(&compact, &prepared);
+	blake3_compact_hasher_update(&compact, v->input, v->len);
+	blake3_compact_hasher_finalize(&compact, out, sizeof(out));
+	check(memcmp(out, want, sizeof(out)) == 0, "blake3_compact_hasher_init_prepared keyed", v->len);
+
+	reference(v, 2, want, sizeof(want));
+	blake3_prepared_key_init_derive_key(&prepared, context);
+	blake3_hasher_init_prepared(&hasher, &prepared);
+	blake3_hasher_update(&hasher, v->input, v->len);
+	blake3_hasher_finalize(&hasher, out, sizeof(out));
+	check(memcmp(out, want, sizeof(out)) == 0, "blake3_hasher_init_prepared derive_key", v->len);
+	blake3_prepared_key_init_derive_key_raw(&prepared, context, strlen(context));
+	blake3_compact_hasher_init_prepared(&compact, &prepared);
+	blake3_compact_hasher_update(&compact, v->input, v->len);
+	blake3_compact_hasher_finalize(&compact, out, sizeof(out));
+	check(memcmp(out, want, sizeof(out)) == 0, "blake3_compact_hasher_init_prepared derive_key_raw", v->len);
+}
+
+static void
+testcompact(const struct vector *v)
+{
+	unsigned char want[XOFLEN], out[XOFLEN];
+	blake3_compact_hasher compact, fork;
+	size_t half = v->len / 2;
+
+	reference(v, 0, want, sizeof(want));
+	blake3_compact_hasher_init(&compact);
+	check(blake3_compact_hasher_update(&compact, v->input, half) == 0, "blake3_compact_hasher_update", v->len);
+	memset(&fork, 0xaa, sizeof(fork));
+	blake3_compact_hasher_fork(&fork, &compact);
+	check(blake3_compact_hasher_update(&compact, v->input + half, v->len - half) == 0, "blake3_compact_hasher_update", v->len);
+	blake3_compact_hasher_finalize(&compact, out, sizeof(out));
+	check(memcmp(out, want, sizeof(out)) == 0, "blake3_compact_hasher", v->len);
+	blake3_compact_hasher_finalize_seek(&compact, 7, out, sizeof(out) - 7);
+	check(memcmp(out, want + 7, sizeof(out) - 7) == 0, "blake3_compact_hasher_finalize_seek", v->len);
+	blake3_compact_hasher_update(&fork, v->input + half, v->len - half);
+	blake3_compact_hasher_finalize(&fork, out, sizeof(out));
+	check(memcmp(out, want, sizeof(out)) == 0, "blake3_compact_hasher_fork", v->len);
+	blake3_compact_hasher_reset(&compact);
+	blake3_compact_hasher_update(&compact, v->input, v->len);
+	blake3_compact_hasher_finalize(&compact, out, sizeof(out));
+	check(memcmp(out, want, sizeof(out)) == 0, "blake3_compact_hasher_reset", v->len);
+
+	reference(v, 1, want, sizeof(want));
+	blake3_compact_hasher_init_keyed(&compact, key);
+	blake3_compact_hasher_update(&compact, v->input, v->len);
+	blake3_compact_hasher_finalize(&compact, out, sizeof(out));
+	check(memcmp(out, want, sizeof(out)) == 0, "blake3_compact_hasher_init_keyed", v->len);
+
+	reference(v, 2, want, sizeof(want));
+	blake3_compact_hasher_init_derive_key(&compact, context);
+	blake3_compact_hasher_update(&compact, v->input, v->len);
+	blake3_compact_hasher_finalize(&compact, out, sizeof(out));
+	check(memcmp(out, want, sizeof(out)) == 0, "blake3_compact_hasher_init_derive_key", v->len);
+	blake3_compact_hasher_init_derive_key_raw(&compact, context, strlen(context));
+	blake3_compact_hasher_update(&compact, v->input, v->len);
+	blake3_compact_hasher_finalize(&compact, out, sizeof(out));
+	check(memcmp(out, want, sizeof(out)) == 0, "blake3_compact_hasher_init_derive_key_raw", v->len);
+}
+
+static void
+testfork(const struct vector *v)
+{
+	unsigned char want[XOFLEN], out[XOFLEN];
+	blake3_hasher prefix, hasher;
+	size_t half = v->len / 2;
+
+	reference(v, 0, want, sizeof(want));
+	blake3_hasher_init(&prefix);
+	blake3_hasher_update(&prefix, v->input, half);
+	memset(&hasher, 0xaa, sizeof(hasher));
+	blake3_hasher_fork(&hasher, &prefix);
+	blake3_hasher_update(&hasher, v->input + half, v->len - half);
+	blake3_hasher_finalize(&hasher, out, sizeof(out));
+	check(memcmp(out, want, sizeof(out)) == 0, "blake3_hasher_fork", v->len);
+	/* forking again restores the end of the prefix */
+	blake3_hasher_fork(&hasher, &prefix);
+	blake3_hasher_update(&hasher, v->input + half, v->len - half);
+	blake3_hasher_finalize(&hasher, out, sizeof(out));
+	check(memcmp(out, want, sizeof(out)) == 0, "blake3_hasher_fork again", v->len);
+}
+
+/* Hash the tree above input from its chunks up, with the low-level tree
+ * functions, writing the root output if root is set. */
+static void
+tree(const unsigned char *input, size_t len, uint64_t counter, int root, unsigned char *out, size_t outlen)
+{
+	unsigned char left[BLAKE3_OUT_LEN], right[BLAKE3_OUT_LEN], whole[BLAKE3_OUT_LEN];
+	size_t leftlen;
+
+	if (len <= BLAKE3_CHUNK_LEN) {
+		check(blake3_subtree_cv(input, len, counter, out) == 0, "blake3_subtree_cv", len);
+		return;
+	}
+	for (leftlen = BLAKE3_CHUNK_LEN; 2 * leftlen < len; leftlen *= 2)
+		;
+	tree(input, leftlen, counter, 0, left, sizeof(left));
+	tree(input + leftlen, len - leftlen, counter + leftlen / BLAKE3_CHUNK_LEN, 0, right, sizeof(right));
+	if (root) {
+		blake3_parent_root(left, right, out, outlen);
+		return;
+	}
+	blake3_parent_cv(left, right, out);
+	/* a whole subtree at once gives the same chaining value */
+	check(blake3_subtree_cv(input, len, counter, whole) == 0, "blake3_subtree_cv", len);
+	check(memcmp(whole, out, BLAKE3_OUT_LEN) == 0, "blake3_subtree_cv", len);
+}
+
+static void
+testtree(const struct vector *v)
+{
+	unsigned char want[XOFLEN], out[XOFLEN], cv[BLAKE3_OUT_LEN];
+
+	if (v->len <= BLAKE3_CHUNK_LEN)
+		return;
+	reference(v, 0, want, sizeof(want));
+	tree(v->input, v->len, 0, 1, out, sizeof(out));
+	check(memcmp(out, want, sizeof(out)) == 0, "blake3_parent_root", v->len);
+	check(blake3_subtree_cv(v->input, v->len, 1, cv) == -1, "blake3_subtree_cv misaligned", v->len);
+	check(blake3_subtree_cv(v->input, 0, 0, cv) == -1, "blake3_subtree_cv empty", v->len);
+}
+
+static void
+testoutboard(const struct vector *v)
+{
+	blake3_outboard_decoder *dec;
+	unsigned char want[BLAKE3_OUT_LEN], hash[BLAKE3_OUT_LEN], *outboard, *input;
+	size_t obsize, i, n;
+	int ret;
+
+	reference(v, 0, want, sizeof(want));
+	obsize = blake3_outboard_size(v->len);
+	outboard = malloc(obsize);
+	input = malloc(v->len ? v->len : 1);
+	dec = malloc(sizeof(*dec));
+	if (!outboard || !input || !dec) {
+		fail("malloc", v->len);
+		goto out;
+	}
+	blake3_outboard_encode(v->input, v->len, outboard, hash);
+	check(memcmp(hash, want, sizeof(want)) == 0, "blake3_outboard_encode", v->len);
+
+	/* intact content, in pieces that don't line up with groups */
+	check(blake3_outboard_decoder_init(dec, hash, outboard, obsize) == 0, "blake3_outboard_decoder_init", v->len);
+	ret = 0;
+	for (i = 0; i < v->len; i += n) {
+		n = v->len - i < 3000 ? v->len - i : 3000;
+		ret |= blake3_outboard_decoder_update(dec, v->input + i, n);
+	}
+	check(ret == 0 && blake3_outboard_decoder_finalize(dec) == 0, "blake3_outboard_decoder", v->len);
+
+	/* a wrong length */
+	check(blake3_outboard_decoder_init(dec, hash, outboard, obsize + 1) == -1, "blake3_outboard_decoder_init length", v->len);
+	if (v->len == 0)
+		goto out;
+
+	/* a corrupted byte in the last group fails by the end of that group */
+	memcpy(input, v->input, v->len);
+	input[v->len - 1] ^= 1;
+	check(blake3_outboard_decoder_init(dec, hash, outboard, obsize) == 0, "blake3_outboard_decoder_init", v->len);
+	ret = blake3_outboard_decoder_update(dec, input, v->len);
+	check((ret | blake3_outboard_decoder_finalize(dec)) == -1, "blake3_outboard_decoder corrupt content", v->len);
+
+	/* a corrupted byte in the first group fails when that group completes,
+	 * and the decoder keeps failing */
+	if (v->len > BLAKE3_OUTBOARD_GROUP_LEN) {
+		memcpy(input, v->input, v->len);
+		input[0] ^= 1;
+		blake3_outboard_decoder_init(dec, hash, outboard, obsize);
+		check(blake3_outboard_decoder_update(dec, input, BLAKE3_OUTBOARD_GROUP_LEN) == -1, "blake3_outboard_decoder corrupt group", v->len);
+		check(blake3_outboard_decoder_update(dec, v->input + BLAKE3_OUTBOARD_GROUP_LEN, v->len - BLAKE3_OUTBOARD_GROUP_LEN) == -1, "blake3_outboard_decoder after failure", v->len);
+		check(blake3_outboard_decoder_finalize(dec) == -1, "blake3_outboard_decoder_finalize after failure", v->len);
+	}
+
+	/* a corrupted parent node */
+	if (obsize > 8) {
+		outboard[obsize - 1] ^= 1;
+		blake3_outboard_decoder_init(dec, hash, outboard, obsize);
+		ret = blake3_outboard_decoder_update(dec, v->input, v->len);
+		check((ret | blake3_outboard_decoder_finalize(dec)) == -1, "blake3_outboard_decoder corrupt outboard", v->len);
+	}
+
+out:
+	free(dec);
+	free(input);
+	free(outboard);
+}
+
+static void
+testbatch(void)
+{
+	const void *inputs[MAXCASES];
+	size_t lens[MAXCASES], i;
+	unsigned char out[MAXCASES * BLAKE3_OUT_LEN], want[BLAKE3_OUT_LEN];
+
+	for (i = 0; i < nvecs; i++) {
+		inputs[i] = vecs[i].input;
+		lens[i] = vecs[i].len;
+	}
+	blake3_hash_batch(inputs, lens, nvecs, out);
+	for (i = 0; i < nvecs; i++) {
+		reference(&vecs[i], 0, want, sizeof(want));
+		check(memcmp(out + i * BLAKE3_OUT_LEN, want, sizeof(want)) == 0, "blake3_hash_batch", vecs[i].len);
+	}
+
+	/* an empty message may be passed as a NULL pointer */
+	inputs[0] = NULL;
+	lens[0] = 0;
+	blake3_hash_batch(inputs, lens, 1, out);
+	reference(&vecs[0], 0, want, sizeof(want));
+	check(memcmp(out, want, sizeof(want)) == 0, "blake3_hash_batch NULL", 0);
+}
+
+/* Feed every input to its own hasher, each starting a different distance
+ * into its stream, in several rounds of uneven pieces. */
+static void
+testmany(void)
+{
+	static blake3_hasher hashers[MAXCASES];
+	blake3_hasher *ptrs[MAXCASES], ref;
+	const void *inputs[MAXCASES];
+	size_t lens[MAXCASES], pos[MAXCASES], skew, i, round;
+	unsigned char out[XOFLEN], want[XOFLEN];
+
+	for (i = 0; i < nvecs; i++) {
+		skew = i * 37 % 2000;
+		if (skew > vecs[i].len)
+			skew = vecs[i].len;
+		blake3_hasher_init(&hashers[i]);
+		blake3_hasher_update(&hashers[i], vecs[i].input, skew);
+		ptrs[i] = &hashers[i];
+		pos[i] = skew;
+	}
+	for (round = 0; round < 4; round++) {
+		for (i = 0; i < nvecs; i++) {
+			inputs[i] = vecs[i].input + pos[i];
+			lens[i] = round == 3 ? vecs[i].len - pos[i] : (vecs[i].len - pos[i]) / (3 - round) / 2;
+			pos[i] += lens[i];
+		}
+		blake3_hasher_update_many(ptrs, inputs, lens, nvecs);
+	}
+	for (i = 0; i < nvecs; i++) {
+		reference(&vecs[i], 0, want, sizeof(want));
+		blake3_hasher_finalize(&hashers[i], out, sizeof(out));
+		check(memcmp(out, want, sizeof(out)) == 0, "blake3_hasher_update_many", vecs[i].len);
+	}
+
+	/* a single long input, which is split across lanes by chunk */
+	blake3_hasher_init(&ref);
+	blake3_hasher_update(&ref, vecs[nvecs - 1].input, vecs[nvecs - 1].len);
+	blake3_hasher_finalize(&ref, want, sizeof(want));
+	blake3_hasher_init(&hashers[0]);
+	inputs[0] = vecs[nvecs - 1].input;
+	lens[0] = vecs[nvecs - 1].len;
+	blake3_hasher_update_many(ptrs, inputs, lens, 1);
+	blake3_hasher_finalize(&hashers[0], out, sizeof(out));
+	check(memcmp(out, want, sizeof(out)) == 0, "blake3_hasher_update_many single", lens[0]);
+}
+
+/* Fill a compact hasher to exactly BLAKE3_COMPACT_MAX_LEN, which must give
+ * the same hash as a regular hasher, and then go one byte past it. */
+static void
+testcompactlimit(void)
+{
+	enum { BUFLEN = 1 << 20 };
+	blake3_compact_hasher compact;
+	blake3_hasher hasher;
+	unsigned char *buf, want[BLAKE3_OUT_LEN], out[BLAKE3_OUT_LEN];
+	uint64_t i;
+	int ret = 0;
+
+	buf = calloc(1, BUFLEN);
+	if (!buf) {
+		fail("calloc", BUFLEN);
+		return;
+	}
+	blake3_hasher_init(&hasher);
+	blake3_compact_hasher_init(&compact);
+	for (i = 0; i < BLAKE3_COMPACT_MAX_LEN; i += BUFLEN) {
+		blake3_hasher_update(&hasher, buf, BUFLEN);
+		ret |= blake3_compact_hasher_update(&compact, buf, BUFLEN);
+	}
+	check(ret == 0, "blake3_compact_hasher_update at limit", 0);
+	check(blake3_compact_hasher_update(&compact, buf, 1) == -1, "blake3_compact_hasher_update past limit", 1);
+	check(blake3_compact_hasher_update(&compact, buf, 0) == 0, "blake3_compact_hasher_update empty at limit", 0);
+	blake3_hasher_finalize(&hasher, want, sizeof(want));
+	blake3_compact_hasher_finalize(&compact, out, sizeof(out));
+	check(memcmp(out, want, sizeof(out)) == 0, "blake3_compact_hasher at limit", 0);
+	free(buf);
+}
+
+/* An executor that counts the tasks it is offered. With threads, it runs
+ * each one on a thread of its own; otherwise, or if decline is set, it
+ * returns NULL and the task runs on the calling thread. */
+struct executor {
+	int decline;
+	unsigned long spawned;
+#ifdef WITH_THREADS
+	pthread_mutex_t lock;
+#endif
+};
+
+#ifdef WITH_THREADS
+struct task {
+	pthread_t thread;
+	void (*fn)(void *);
+	void *arg;
+};
+
+static void *
+taskrun(void *arg)
+{
+	struct task *t = arg;
+
+	t->fn(t->arg);
+	return NULL;
+}
+#endif
+
+static void *
+taskspawn(void *ctx, void (*fn)(void *), void *arg)
+{
+	struct executor *e = ctx;
+#ifdef WITH_THREADS
+	struct task *t;
+
+	pthread_mutex_lock(&e->lock);
+	e->spawned++;
+	pthread_mutex_unlock(&e->lock);
+	if (e->decline || !(t = malloc(sizeof(*t))))
+		return NULL;
+	t->fn = fn;
+	t->arg = arg;
+	if (pthread_create(&t->thread, NULL, taskrun, t) != 0) {
+		free(t);
+		return NULL;
+	}
+	return t;
+#else
+	(void)fn;
+	(void)arg;
+	e->spawned++;
+	return NULL;
+#endif
+}
+
+static void
+taskjoin(void *ctx, void *handle)
+{
+#ifdef WITH_THREADS
+	struct task *t = handle;
+
+	(void)ctx;
+	pthread_join(t->thread, NULL);
+	free(t);
+#else
+	(void)ctx;
+	(void)handle;
+#endif
+}
+
+/* Hash inputs on either side of the split threshold, with chunk counts
+ * that aren't powers of two, through executors that run the tasks and
+ * that decline them. The output must match a serial hasher. */
+static void
+testparallel(void)
+{
+	static const size_t lens[] = {
+		SPLITLEN - BLAKE3_CHUNK_LEN, SPLITLEN - 1, SPLITLEN, SPLITLEN + 1,
+		SPLITLEN + 3 * BLAKE3_CHUNK_LEN + 17, 3 * SPLITLEN / 2 + 5 * BLAKE3_CHUNK_LEN,
+		5 * SPLITLEN / 2 + 7 * BLAKE3_CHUNK_LEN + 1,
+	};
+	static unsigned char *buf;
+	const size_t maxlen = 5 * SPLITLEN / 2 + 7 * BLAKE3_CHUNK_LEN + 1;
+	struct executor e;
+	blake3_executor exec = {taskspawn, taskjoin, &e};
+	blake3_hasher hasher;
+	unsigned char want[XOFLEN], out[XOFLEN];
+	size_t i, skip;
+
+	if (!buf) {
+		buf = malloc(maxlen);
+		if (!buf) {
+			fail("malloc", maxlen);
+			return;
+		}
+		for (i = 0; i < maxlen; i++)
+			buf[i] = i % 251;
+	}
+#ifdef WITH_THREADS
+	pthread_mutex_init(&e.lock, NULL);
+#endif
+	for (i = 0; i < sizeof(lens) / sizeof(lens[0]); i++) {
+		blake3_hasher_init(&hasher);
+		blake3_hasher_update_parallel(&hasher, buf, lens[i], NULL);
+		blake3_hasher_finalize(&hasher, want, sizeof(want));
+		blake3_hasher_init(&hasher);
+		blake3_hasher_update(&hasher, buf, lens[i]);
+		blake3_hasher_finalize(&hasher, out, sizeof(out));
+		check(memcmp(out, want, sizeof(out)) == 0, "blake3_hasher_update", lens[i]);
+		for (e.decline = 0; e.decline < 2; e.decline++) {
+			/* the whole input, and then after an odd first chunk,
+			 * which shrinks the subtrees that follow */
+			for (skip = 0; skip <= 1000; skip += 1000) {
+				e.spawned = 0;
+				blake3_hasher_init(&hasher);
+				blake3_hasher_update(&hasher, buf, skip);
+				blake3_hasher_update_parallel(&hasher, buf + skip, lens[i] - skip, &exec);
+				blake3_hasher_finalize(&hasher, out, sizeof(out));
+				check(memcmp(out, want, sizeof(out)) == 0, e.decline ? "blake3_hasher_update_parallel declined" : "blake3_hasher_update_parallel", lens[i]);
+				if (skip == 0)
+					check((e.spawned > 0) == (lens[i] >= SPLITLEN), "blake3_hasher_update_parallel threshold", lens[i]);
+			}
+		}
+	}
+#ifdef WITH_THREADS
+	pthread_mutex_destroy(&e.lock);
+#endif
+}
+
+int
+main(int argc, char *argv[])
+{
+	static const char *backends[] = {"portable", "sse2", "sse41", "avx2", "avx512"};
+	size_t i, j;
+
+	argv0 = argc ? argv[0] : "b3test";
+	if (argc != 2) {
+		fprintf(stderr, "usage: %s test_vectors.json\n", argv0);
+		return 1;
+	}
+	if (load(argv[1]) != 0)
+		return 1;
+
+	for (i = 0; i < sizeof(backends) / sizeof(backends[0]); i++) {
+		/* skip backends this build or CPU doesn't have */
+		if (blake3_set_backend(backends[i]) != 0)
+			continue;
+		backend = backends[i];
+		for (j = 0; j < nvecs; j++) {
+			testhasher(&vecs[j]);
+			testoneshot(&vecs[j]);
+			testprepared(&vecs[j]);
+			testcompact(&vecs[j]);
+			testfork(&vecs[j]);
+			testtree(&vecs[j]);
+			testoutboard(&vecs[j]);
+		}
+		testbatch();
+		testmany();
+		testparallel();
+	}
+	blake3_set_backend(NULL);
+	backend = blake3_get_backend();
+	testcompactlimit();
+
+	return failed;
+}
@@ -1,7 +1,17 @@
+#if defined(WITH_THREADS)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 #include <assert.h>
 #include <stdbool.h>
+#include <stdlib.h>
 #include <string.h>
 
+#if defined(WITH_THREADS)
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
 #include "blake3.h"
 #include "blake3_impl.h"
 
@@ -112,7 +122,7 @@ INLINE void output_root_bytes(const output_t *self, uint64_t seek, uint8_t *out,
   uint64_t output_block_counter = seek / 64;
   size_t offset_within_block = seek % 64;
   uint8_t wide_buf[64];
-  while (out_len > 0) {
+  if (offset_within_block > 0) {
     blake3_compress_xof(self->input_cv, self->block, self->block_len,
                         output_block_counter, self->flags | ROOT, wide_buf);
     size_t available_bytes = 64 - offset_within_block;
@@ -126,7 +136,19 @@ INLINE void output_root_bytes(const output_t *self, uint64_t seek, uint8_t *out,
     out += memcpy_len;
     out_len -= memcpy_len;
     output_block_counter += 1;
-    offset_within_block = 0;
+  }
+  // Whole output blocks are written in place, several at a time when the
+  // platform has a wide XOF kernel.
+  size_t full_blocks = out_len / 64;
+  blake3_xof_many(self->input_cv, self->block, self->block_len,
+                  output_block_counter, self->flags | ROOT, out, full_blocks);
+  out += full_blocks * 64;
+  out_len -= full_blocks * 64;
+  output_block_counter += full_blocks;
+  if (out_len > 0) {
+    blake3_compress_xof(self->input_cv, self->block, self->block_len,
+                        output_block_counter, self->flags | ROOT, wide_buf);
+    memcpy(out, wide_buf, out_len);
   }
 }
 
@@ -284,6 +306,160 @@ INLINE size_t compress_parents_parallel(const uint8_t *child_chaining_values,
   }
 }
 
+static size_t blake3_compress_subtree_wide(const uint8_t *input,
+                                           size_t input_len,
+                                           const uint32_t key[8],
+                                           uint64_t chunk_counter,
+                                           uint8_t flags, uint8_t *out,
+                                           const blake3_executor *executor);
+
+// Subtrees shorter than this are never split into separate tasks. Starting
+// and joining a thread costs tens of microseconds, which is about how long it
+// takes to hash a few hundred KiB with the wider SIMD implementations.
+#define PARALLEL_MIN_LEN (1024 * BLAKE3_CHUNK_LEN)
+
+typedef struct {
+  const uint8_t *input;
+  size_t input_len;
+  const uint32_t *key;
+  uint64_t chunk_counter;
+  uint8_t flags;
+  uint8_t *out;
+  const blake3_executor *executor;
+  size_t out_len;
+} subtree_job;
+
+static void subtree_job_run(void *arg) {
+  subtree_job *job = (subtree_job *)arg;
+  job->out_len = blake3_compress_subtree_wide(job->input, job->input_len,
+                                              job->key, job->chunk_counter,
+                                              job->flags, job->out,
+                                              job->executor);
+}
+
+#if defined(WITH_THREADS)
+// The executor used by blake3_hasher_update() and the other functions that
+// take no executor. It hands tasks to a pool of one worker per online CPU
+// but one, shared by every hasher in the process and started on first use.
+// A task is only accepted when a worker is idle, so it never waits in the
+// queue behind other work, and a task that joins its own subtasks can't
+// deadlock the pool.
+typedef struct pool_task {
+  void (*task)(void *);
+  void *arg;
+  bool done;
+  struct pool_task *next;
+} pool_task;
+
+static pthread_once_t pool_once = PTHREAD_ONCE_INIT;
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t pool_queued = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t pool_finished = PTHREAD_COND_INITIALIZER;
+static pool_task *pool_head;
+static pool_task *pool_tail;
+static size_t pool_idle;
+
+static void *pool_worker(void *arg) {
+  (void)arg;
+  pthread_mutex_lock(&pool_lock);
+  for (;;) {
+    while (pool_head == NULL) {
+      pthread_cond_wait(&pool_queued, &pool_lock);
+    }
+    pool_task *t = pool_head;
+    pool_head = t->next;
+    if (pool_head == NULL) {
+      pool_tail = NULL;
+    }
+    pthread_mutex_unlock(&pool_lock);
+    t->task(t->arg);
+    pthread_mutex_lock(&pool_lock);
+    t->done = true;
+    pool_idle += 1;
+    pthread_cond_broadcast(&pool_finished);
+  }
+  return NULL;
+}
+
+// A child process has none of the workers, so it hashes on its own thread.
+// The lock is held across fork() so that the child gets it unlocked and the
+// queue consistent.
+static void pool_prepare(void) { pthread_mutex_lock(&pool_lock); }
+
+static void pool_parent(void) { pthread_mutex_unlock(&pool_lock); }
+
+static void pool_child(void) {
+  pool_head = NULL;
+  pool_tail = NULL;
+  pool_idle = 0;
+  pthread_mutex_unlock(&pool_lock);
+}
+
+static void pool_init(void) {
+  long n = sysconf(_SC_NPROCESSORS_ONLN);
+  pthread_attr_t attr;
+  pthread_t thread;
+
+  if (n <= 1 || pthread_atfork(pool_prepare, pool_parent, pool_child) != 0 ||
+      pthread_attr_init(&attr) != 0) {
+    return;
+  }
+  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+  for (long i = 0; i < n - 1; i++) {
+    if (pthread_create(&thread, &attr, pool_worker, NULL) != 0) {
+      break;
+    }
+    pool_idle += 1;
+  }
+  pthread_attr_destroy(&attr);
+}
+
+static void *pool_spawn(void *ctx, void (*task)(void *), void *arg) {
+  (void)ctx;
+  pthread_once(&pool_once, pool_init);
+  pool_task *t = (pool_task *)malloc(sizeof(*t));
+  if (t == NULL) {
+    return NULL;
+  }
+  t->task = task;
+  t->arg = arg;
+  t->done = false;
+  t->next = NULL;
+  pthread_mutex_lock(&pool_lock);
+  if (pool_idle == 0) {
+    pthread_mutex_unlock(&pool_lock);
+    free(t);
+    return NULL;
+  }
+  pool_idle -= 1;
+  if (pool_tail != NULL) {
+    pool_tail->next = t;
+  } else {
+    pool_head = t;
+  }
+  pool_tail = t;
+  pthread_cond_signal(&pool_queued);
+  pthread_mutex_unlock(&pool_lock);
+  return t;
+}
+
+static void pool_join(void *ctx, void *handle) {
+  pool_task *t = (pool_task *)handle;
+  (void)ctx;
+  pthread_mutex_lock(&pool_lock);
+  while (!t->done) {
+    pthread_cond_wait(&pool_finished, &pool_lock);
+  }
+  pthread_mutex_unlock(&pool_lock);
+  free(t);
+}
+
+static const blake3_executor pool_executor = {pool_spawn, pool_join, NULL};
+#define DEFAULT_EXECUTOR (&pool_executor)
+#else
+#define DEFAULT_EXECUTOR NULL
+#endif
+
 // The wide helper function returns (writes out) an array of chaining values
 // and returns the length of that array. The number of chaining values returned
 // is the dynamically detected SIMD degree, at most MAX_SIMD_DEGREE. Or fewer,
@@ -301,15 +477,19 @@ INLINE size_t compress_parents_parallel(const uint8_t *child_chaining_values,
 // Why not just have the caller split the input on the first update(), instead
 // of implementing this special rule? Because we don't want to limit SIMD or
 // multi-threading parallelism for that update().
+//
+// If an executor is given and the subtree is large enough, the left half is
+// handed to it as a separate task while the calling thread hashes the right
+// half, and then the two are joined.
 static size_t blake3_compress_subtree_wide(const uint8_t *input,
                                            size_t input_len,
                                            const uint32_t key[8],
                                            uint64_t chunk_counter,
-                                           uint8_t flags, uint8_t *out) {
+                                           uint8_t flags, uint8_t *out,
+                                           const blake3_executor *executor) {
   // Note that the single chunk case does *not* bump the SIMD degree up to 2
-  // when it is 1. If this implementation adds multi-threading in the future,
-  // this gives us the option of multi-threading even the 2-chunk case, which
-  // can help performance on smaller platforms.
+  // when it is 1. This gives us the option of multi-threading even the
+  // 2-chunk case, which can help performance on smaller platforms.
   if (input_len <= blake3_simd_degree() * BLAKE3_CHUNK_LEN) {
     return compress_chunks_parallel(input, input_len, key, chunk_counter, flags,
                                     out);
@@ -339,12 +519,30 @@ static size_t blake3_compress_subtree_wide(const uint8_t *input,
   }
   uint8_t *right_cvs = &cv_array[degree * BLAKE3_OUT_LEN];
 
-  // Recurse! If this implementation adds multi-threading support in the
-  // future, this is where it will go.
-  size_t left_n = blake3_compress_subtree_wide(input, left_input_len, key,
-                                               chunk_counter, flags, cv_array);
-  size_t right_n = blake3_compress_subtree_wide(
-      right_input, right_input_len, key, right_chunk_counter, flags, right_cvs);
+  // Recurse! If the executor accepts the left subtree as a separate task,
+  // hash the right subtree on this thread while it runs. Otherwise, hash both
+  // subtrees here, one after the other.
+  size_t left_n, right_n;
+  subtree_job job = {input, left_input_len, key, chunk_counter, flags,
+                     cv_array, executor, 0};
+  void *handle = NULL;
+  if (executor != NULL && right_input_len >= PARALLEL_MIN_LEN) {
+    handle = executor->spawn(executor->ctx, subtree_job_run, &job);
+  }
+  if (handle != NULL) {
+    right_n = blake3_compress_subtree_wide(right_input, right_input_len, key,
+                                           right_chunk_counter, flags,
+                                           right_cvs, executor);
+    executor->join(executor->ctx, handle);
+    left_n = job.out_len;
+  } else {
+    left_n = blake3_compress_subtree_wide(input, left_input_len, key,
+                                          chunk_counter, flags, cv_array,
+                                          executor);
+    right_n = blake3_compress_subtree_wide(right_input, right_input_len, key,
+                                           right_chunk_counter, flags,
+                                           right_cvs, executor);
+  }
 
   // The special case again. If simd_degree=1, then we'll have left_n=1 and
   // right_n=1. Rather than compressing them into a single output, return
@@ -372,39 +570,86 @@ static size_t blake3_compress_subtree_wide(const uint8_t *input,
 // chunk or less. That's a different codepath.
 INLINE void compress_subtree_to_parent_node(
     const uint8_t *input, size_t input_len, const uint32_t key[8],
-    uint64_t chunk_counter, uint8_t flags, uint8_t out[2 * BLAKE3_OUT_LEN]) {
+    uint64_t chunk_counter, uint8_t flags, uint8_t out[2 * BLAKE3_OUT_LEN],
+    const blake3_executor *executor) {
   assert(input_len > BLAKE3_CHUNK_LEN);
 
   uint8_t cv_array[MAX_SIMD_DEGREE_OR_2 * BLAKE3_OUT_LEN];
-  size_t num_cvs = blake3_compress_subtree_wide(input, input_len, key,
-                                                chunk_counter, flags, cv_array);
+  size_t num_cvs = blake3_compress_subtree_wide(
+      input, input_len, key, chunk_counter, flags, cv_array, executor);
   assert(num_cvs <= MAX_SIMD_DEGREE_OR_2);
 
   // If MAX_SIMD_DEGREE is greater than 2 and there's enough input,
   // compress_subtree_wide() returns more than 2 chaining values. Condense
-  // them into 2 by forming parent nodes repeatedly.
+  // them into 2 by forming parent nodes repeatedly. Each layer is written to
+  // the other buffer rather than copied back, and the last one, from 3 or 4
+  // chaining values, goes straight to out.
   uint8_t out_array[MAX_SIMD_DEGREE_OR_2 * BLAKE3_OUT_LEN / 2];
+  uint8_t *layer = cv_array;
+  uint8_t *next = out_array;
   // The second half of this loop condition is always true, and we just
   // asserted it above. But GCC can't tell that it's always true, and if NDEBUG
   // is set on platforms where MAX_SIMD_DEGREE_OR_2 == 2, GCC emits spurious
   // warnings here. GCC 8.5 is particularly sensitive, so if you're changing
   // this code, test it against that version.
-  while (num_cvs > 2 && num_cvs <= MAX_SIMD_DEGREE_OR_2) {
-    num_cvs =
-        compress_parents_parallel(cv_array, num_cvs, key, flags, out_array);
-    memcpy(cv_array, out_array, num_cvs * BLAKE3_OUT_LEN);
+  while (num_cvs > 4 && num_cvs <= MAX_SIMD_DEGREE_OR_2) {
+    num_cvs = compress_parents_parallel(layer, num_cvs, key, flags, next);
+    uint8_t *tmp = layer;
+    layer = next;
+    next = tmp;
+  }
+  if (num_cvs > 2) {
+    compress_parents_parallel(layer, num_cvs, key, flags, out);
+  } else {
+    memcpy(out, layer, 2 * BLAKE3_OUT_LEN);
+  }
+}
+
+// Hash a whole input without a hasher. A single chunk is compressed straight
+// from the input, with only the last block copied (to zero-pad it). Anything
+// longer is one subtree whose top parent node is known to be the root.
+static void hash_oneshot(const uint32_t key[8], uint8_t flags,
+                         const uint8_t *input, size_t input_len, uint8_t *out,
+                         size_t out_len) {
+  if (out_len == 0) {
+    return;
   }
-  memcpy(out, cv_array, 2 * BLAKE3_OUT_LEN);
+  output_t output;
+  if (input_len <= BLAKE3_CHUNK_LEN) {
+    uint32_t cv[8];
+    memcpy(cv, key, BLAKE3_KEY_LEN);
+    uint8_t start = CHUNK_START;
+    while (input_len > BLAKE3_BLOCK_LEN) {
+      blake3_compress_in_place(cv, input, BLAKE3_BLOCK_LEN, 0, flags | start);
+      start = 0;
+      input += BLAKE3_BLOCK_LEN;
+      input_len -= BLAKE3_BLOCK_LEN;
+    }
+    uint8_t block[BLAKE3_BLOCK_LEN] = {0};
+    if (input_len > 0) {
+      memcpy(block, input, input_len);
+    }
+    output = make_output(cv, block, (uint8_t)input_len, 0,
+                         flags | start | CHUNK_END);
+  } else {
+    uint8_t cv_pair[2 * BLAKE3_OUT_LEN];
+    compress_subtree_to_parent_node(input, input_len, key, 0, flags, cv_pair,
+                                    DEFAULT_EXECUTOR);
+    output = parent_output(cv_pair, key, flags);
+  }
+  output_root_bytes(&output, 0, out, out_len);
 }
 
-INLINE void hasher_init_base(blake3_hasher *self, const uint32_t key[8],
+INLINE void hasher_init_base(blake3_hasher_state *self, const uint32_t key[8],
                              uint8_t flags) {
   memcpy(self->key, key, BLAKE3_KEY_LEN);
   chunk_state_init(&self->chunk, key, flags);
   self->cv_stack_len = 0;
 }
 
-void blake3_hasher_init(blake3_hasher *self) { hasher_init_base(self, IV, 0); }
+void blake3_hasher_init(blake3_hasher *self) {
+  hasher_init_base(&self->state, IV, 0);
+}
 
 INLINE void load_key_words(const uint8_t key[BLAKE3_KEY_LEN],
                            uint32_t key_words[8]) {
@@ -422,19 +667,30 @@ void blake3_hasher_init_keyed(blake3_hasher *self,
                               const uint8_t key[BLAKE3_KEY_LEN]) {
   uint32_t key_words[8];
   load_key_words(key, key_words);
-  hasher_init_base(self, key_words, KEYED_HASH);
+  hasher_init_base(&self->state, key_words, KEYED_HASH);
+}
+
+static void hasher_update(blake3_hasher_state *self, uint8_t *cv_stack,
+                          const void *input, size_t input_len,
+                          const blake3_executor *executor);
+static void hasher_finalize_seek(const blake3_hasher_state *self,
+                                 const uint8_t *cv_stack, uint64_t seek,
+                                 uint8_t *out, size_t out_len);
+
+// Hash a key derivation context string into the key for its key material.
+static void hasher_context_key(const void *context, size_t context_len,
+                               uint32_t context_key_words[8]) {
+  uint8_t context_key[BLAKE3_KEY_LEN];
+  hash_oneshot(IV, DERIVE_KEY_CONTEXT, (const uint8_t *)context, context_len,
+               context_key, BLAKE3_KEY_LEN);
+  load_key_words(context_key, context_key_words);
 }
 
 void blake3_hasher_init_derive_key_raw(blake3_hasher *self, const void *context,
                                        size_t context_len) {
-  blake3_hasher context_hasher;
-  hasher_init_base(&context_hasher, IV, DERIVE_KEY_CONTEXT);
-  blake3_hasher_update(&context_hasher, context, context_len);
-  uint8_t context_key[BLAKE3_KEY_LEN];
-  blake3_hasher_finalize(&context_hasher, context_key, BLAKE3_KEY_LEN);
   uint32_t context_key_words[8];
-  load_key_words(context_key, context_key_words);
-  hasher_init_base(self, context_key_words, DERIVE_KEY_MATERIAL);
+  hasher_context_key(context, context_len, context_key_words);
+  hasher_init_base(&self->state, context_key_words, DERIVE_KEY_MATERIAL);
 }
 
 // Count the number of 1 bits.
@@ -455,6 +711,56 @@ void blake3_hasher_init_derive_key(blake3_hasher *self, const char *context) {
   blake3_hasher_init_derive_key_raw(self, context, strlen(context));
 }
 
+void blake3_prepared_key_init_keyed(blake3_prepared_key *self,
+                                    const uint8_t key[BLAKE3_KEY_LEN]) {
+  load_key_words(key, self->key);
+  self->flags = KEYED_HASH;
+}
+
+void blake3_prepared_key_init_derive_key(blake3_prepared_key *self,
+                                         const char *context) {
+  blake3_prepared_key_init_derive_key_raw(self, context, strlen(context));
+}
+
+void blake3_prepared_key_init_derive_key_raw(blake3_prepared_key *self,
+                                             const void *context,
+                                             size_t context_len) {
+  hasher_context_key(context, context_len, self->key);
+  self->flags = DERIVE_KEY_MATERIAL;
+}
+
+void blake3_hash(const void *input, size_t input_len, uint8_t *out,
+                 size_t out_len) {
+  hash_oneshot(IV, 0, (const uint8_t *)input, input_len, out, out_len);
+}
+
+void blake3_hash_keyed(const uint8_t key[BLAKE3_KEY_LEN], const void *input,
+                       size_t input_len, uint8_t *out, size_t out_len) {
+  uint32_t key_words[8];
+  load_key_words(key, key_words);
+  hash_oneshot(key_words, KEYED_HASH, (const uint8_t *)input, input_len, out,
+               out_len);
+}
+
+void blake3_hash_derive_key(const char *context, const void *input,
+                            size_t input_len, uint8_t *out, size_t out_len) {
+  uint32_t context_key_words[8];
+  hasher_context_key(context, strlen(context), context_key_words);
+  hash_oneshot(context_key_words, DERIVE_KEY_MATERIAL, (const uint8_t *)input,
+               input_len, out, out_len);
+}
+
+void blake3_hash_prepared(const blake3_prepared_key *key, const void *input,
+                          size_t input_len, uint8_t *out, size_t out_len) {
+  hash_oneshot(key->key, key->flags, (const uint8_t *)input, input_len, out,
+               out_len);
+}
+
+void blake3_hasher_init_prepared(blake3_hasher *self,
+                                 const blake3_prepared_key *key) {
+  hasher_init_base(&self->state, key->key, key->flags);
+}
+
 // As described in hasher_push_cv() below, we do "lazy merging", delaying
 // merges until right before the next CV is about to be added. This is
 // different from the reference implementation. Another difference is that we
@@ -465,11 +771,12 @@ void blake3_hasher_init_derive_key(blake3_hasher *self, const char *context) {
 // that doesn't require us to retain the subtree size of the CV on top of the
 // stack. The principle is the same: each CV that should remain in the stack is
 // represented by a 1-bit in the total number of chunks (or bytes) so far.
-INLINE void hasher_merge_cv_stack(blake3_hasher *self, uint64_t total_len) {
+INLINE void hasher_merge_cv_stack(blake3_hasher_state *self, uint8_t *cv_stack,
+                                  uint64_t total_len) {
   size_t post_merge_stack_len = (size_t)popcnt(total_len);
   while (self->cv_stack_len > post_merge_stack_len) {
     uint8_t *parent_node =
-        &self->cv_stack[(self->cv_stack_len - 2) * BLAKE3_OUT_LEN];
+        &cv_stack[(self->cv_stack_len - 2) * BLAKE3_OUT_LEN];
     output_t output = parent_output(parent_node, self->key, self->chunk.flags);
     output_chaining_value(&output, parent_node);
     self->cv_stack_len -= 1;
@@ -508,16 +815,18 @@ INLINE void hasher_merge_cv_stack(blake3_hasher *self, uint64_t total_len) {
 // merging with each of them separately, so that the second CV will always
 // remain unmerged. (That also helps us support extendable output when we're
 // hashing an input all-at-once.)
-INLINE void hasher_push_cv(blake3_hasher *self, uint8_t new_cv[BLAKE3_OUT_LEN],
+INLINE void hasher_push_cv(blake3_hasher_state *self, uint8_t *cv_stack,
+                           uint8_t new_cv[BLAKE3_OUT_LEN],
                            uint64_t chunk_counter) {
-  hasher_merge_cv_stack(self, chunk_counter);
-  memcpy(&self->cv_stack[self->cv_stack_len * BLAKE3_OUT_LEN], new_cv,
+  hasher_merge_cv_stack(self, cv_stack, chunk_counter);
+  memcpy(&cv_stack[self->cv_stack_len * BLAKE3_OUT_LEN], new_cv,
          BLAKE3_OUT_LEN);
   self->cv_stack_len += 1;
 }
 
-void blake3_hasher_update(blake3_hasher *self, const void *input,
-                          size_t input_len) {
+static void hasher_update(blake3_hasher_state *self, uint8_t *cv_stack,
+                          const void *input, size_t input_len,
+                          const blake3_executor *executor) {
   // Explicitly checking for zero avoids causing UB by passing a null pointer
   // to memcpy. This comes up in practice with things like:
   //   std::vector<uint8_t> v;
@@ -544,7 +853,7 @@ void blake3_hasher_update(blake3_hasher *self, const void *input,
       output_t output = chunk_state_output(&self->chunk);
       uint8_t chunk_cv[32];
       output_chaining_value(&output, chunk_cv);
-      hasher_push_cv(self, chunk_cv, self->chunk.chunk_counter);
+      hasher_push_cv(self, cv_stack, chunk_cv, self->chunk.chunk_counter);
       chunk_state_reset(&self->chunk, self->key, self->chunk.chunk_counter + 1);
     } else {
       return;
@@ -553,8 +862,8 @@ void blake3_hasher_update(blake3_hasher *self, const void *input,
 
   // Now the chunk_state is clear, and we have more input. If there's more than
   // a single chunk (so, definitely not the root chunk), hash the largest whole
-  // subtree we can, with the full benefits of SIMD (and maybe in the future,
-  // multi-threading) parallelism. Two restrictions:
+  // subtree we can, with the full benefits of SIMD and multi-threading
+  // parallelism. Two restrictions:
   // - The subtree has to be a power-of-2 number of chunks. Only subtrees along
   //   the right edge can be incomplete, and we don't know where the right edge
   //   is going to be until we get to finalize().
@@ -596,16 +905,16 @@ void blake3_hasher_update(blake3_hasher *self, const void *input,
       output_t output = chunk_state_output(&chunk_state);
       uint8_t cv[BLAKE3_OUT_LEN];
       output_chaining_value(&output, cv);
-      hasher_push_cv(self, cv, chunk_state.chunk_counter);
+      hasher_push_cv(self, cv_stack, cv, chunk_state.chunk_counter);
     } else {
       // This is the high-performance happy path, though getting here depends
       // on the caller giving us a long enough input.
       uint8_t cv_pair[2 * BLAKE3_OUT_LEN];
       compress_subtree_to_parent_node(input_bytes, subtree_len, self->key,
                                       self->chunk.chunk_counter,
-                                      self->chunk.flags, cv_pair);
-      hasher_push_cv(self, cv_pair, self->chunk.chunk_counter);
-      hasher_push_cv(self, &cv_pair[BLAKE3_OUT_LEN],
+                                      self->chunk.flags, cv_pair, executor);
+      hasher_push_cv(self, cv_stack, cv_pair, self->chunk.chunk_counter);
+      hasher_push_cv(self, cv_stack, &cv_pair[BLAKE3_OUT_LEN],
                      self->chunk.chunk_counter + (subtree_chunks / 2));
     }
     self->chunk.chunk_counter += subtree_chunks;
@@ -621,16 +930,172 @@ void blake3_hasher_update(blake3_hasher *self, const void *input,
   // simplifies blake3_hasher_finalize below.
   if (input_len > 0) {
     chunk_state_update(&self->chunk, input_bytes, input_len);
-    hasher_merge_cv_stack(self, self->chunk.chunk_counter);
+    hasher_merge_cv_stack(self, cv_stack, self->chunk.chunk_counter);
   }
 }
 
-void blake3_hasher_finalize(const blake3_hasher *self, uint8_t *out,
-                            size_t out_len) {
-  blake3_hasher_finalize_seek(self, 0, out, out_len);
+void blake3_hasher_update(blake3_hasher *self, const void *input,
+                          size_t input_len) {
+  hasher_update(&self->state, self->cv_stack, input, input_len,
+                DEFAULT_EXECUTOR);
 }
 
-void blake3_hasher_finalize_seek(const blake3_hasher *self, uint64_t seek,
+void blake3_hasher_update_parallel(blake3_hasher *self, const void *input,
+                                   size_t input_len,
+                                   const blake3_executor *executor) {
+  hasher_update(&self->state, self->cv_stack, input, input_len, executor);
+}
+
+// blake3_hasher_update_many() splits each input at chunk boundaries and gives
+// every piece a lane of its own. Only the first piece continues the chunk in
+// the hasher's chunk state. The pieces after it are whole new chunks, which
+// don't depend on anything before them, so one input can fill several lanes
+// of the same call. Afterwards the lanes are taken back in order: each
+// finished chunk goes onto the CV stack, and the input's last block, which
+// the last lane leaves over, goes into the chunk state.
+
+// Before an input gets any lanes, a partly filled block in its chunk state is
+// completed from the input, and compressed if more input follows.
+static void hasher_lanes_head(blake3_hasher_state *self, uint8_t *cv_stack,
+                              const uint8_t **input, size_t *input_len) {
+  blake3_chunk_state *chunk = &self->chunk;
+  if (chunk->buf_len == 0) {
+    return;
+  }
+  size_t take = chunk_state_fill_buf(chunk, *input, *input_len);
+  *input += take;
+  *input_len -= take;
+  if (*input_len == 0) {
+    return;
+  }
+  // If the buffered block ends the chunk, that chunk isn't the root.
+  if (chunk_state_len(chunk) == BLAKE3_CHUNK_LEN) {
+    output_t output = chunk_state_output(chunk);
+    uint8_t chunk_cv[BLAKE3_OUT_LEN];
+    output_chaining_value(&output, chunk_cv);
+    hasher_push_cv(self, cv_stack, chunk_cv, chunk->chunk_counter);
+    chunk_state_reset(chunk, self->key, chunk->chunk_counter + 1);
+  } else {
+    blake3_compress_in_place(chunk->cv, chunk->buf, BLAKE3_BLOCK_LEN,
+                             chunk->chunk_counter,
+                             chunk->flags | chunk_state_maybe_start_flag(chunk));
+    chunk->blocks_compressed += 1;
+    chunk->buf_len = 0;
+    memset(chunk->buf, 0, BLAKE3_BLOCK_LEN);
+  }
+}
+
+// Sets up a lane for the next piece of an input, which already has `planned`
+// lanes ahead of it in the same call. A piece that reaches the end of its
+// chunk with more input to come finishes the chunk. Otherwise it's the last
+// piece, and its last block, even if full, is left over in *tail_len.
+static void hasher_lane_plan(const blake3_hasher_state *self, size_t planned,
+                             const uint8_t **input, size_t *input_len,
+                             blake3_lane *lane, size_t *tail_len) {
+  const blake3_chunk_state *chunk = &self->chunk;
+  size_t room = BLAKE3_CHUNK_LEN;
+  if (planned == 0) {
+    room -= chunk_state_len(chunk);
+    memcpy(lane->cv, chunk->cv, BLAKE3_OUT_LEN);
+    lane->flags_start = chunk_state_maybe_start_flag(chunk);
+  } else {
+    memcpy(lane->cv, self->key, BLAKE3_KEY_LEN);
+    lane->flags_start = CHUNK_START;
+  }
+  lane->input = *input;
+  lane->counter = chunk->chunk_counter + planned;
+  lane->flags = chunk->flags;
+  if (*input_len > room) {
+    lane->blocks = room / BLAKE3_BLOCK_LEN;
+    lane->flags_end = CHUNK_END;
+    *tail_len = 0;
+  } else {
+    lane->blocks = (*input_len - 1) / BLAKE3_BLOCK_LEN;
+    lane->flags_end = 0;
+    *tail_len = *input_len - lane->blocks * BLAKE3_BLOCK_LEN;
+  }
+  *input += lane->blocks * BLAKE3_BLOCK_LEN + *tail_len;
+  *input_len -= lane->blocks * BLAKE3_BLOCK_LEN + *tail_len;
+}
+
+static void hasher_lane_finish(blake3_hasher_state *self, uint8_t *cv_stack,
+                               blake3_lane *lane, size_t tail_len) {
+  blake3_chunk_state *chunk = &self->chunk;
+  if (lane->flags_end == CHUNK_END) {
+    uint8_t chunk_cv[BLAKE3_OUT_LEN];
+    store_cv_words(chunk_cv, lane->cv);
+    hasher_push_cv(self, cv_stack, chunk_cv, chunk->chunk_counter);
+    chunk_state_reset(chunk, self->key, chunk->chunk_counter + 1);
+  } else {
+    memcpy(chunk->cv, lane->cv, BLAKE3_OUT_LEN);
+    chunk->blocks_compressed += (uint8_t)lane->blocks;
+    chunk_state_update(chunk, &lane->input[lane->blocks * BLAKE3_BLOCK_LEN],
+                       tail_len);
+    hasher_merge_cv_stack(self, cv_stack, chunk->chunk_counter);
+  }
+}
+
+void blake3_hasher_update_many(blake3_hasher *const *hashers,
+                               const void *const *inputs,
+                               const size_t *input_lens, size_t num_hashers) {
+  // Inputs this long fill the SIMD lanes by themselves, and without a lane
+  // kernel there's nothing to gain from hashing inputs side by side. The
+  // backend is loaded once, so that the lane kernel can't disappear halfway.
+  const blake3_backend *backend = blake3_backend_active();
+  size_t long_len = backend->simd_degree * BLAKE3_CHUNK_LEN;
+  if (backend->compress_lanes == NULL) {
+    long_len = 0;
+  }
+
+  blake3_lane lanes[MAX_SIMD_DEGREE];
+  blake3_hasher *owners[MAX_SIMD_DEGREE];
+  size_t tail_lens[MAX_SIMD_DEGREE];
+  blake3_hasher *hasher = NULL;
+  const uint8_t *input = NULL;
+  size_t input_len = 0;
+  size_t next = 0;
+  for (;;) {
+    size_t num_lanes = 0;
+    size_t planned = 0;
+    while (num_lanes < MAX_SIMD_DEGREE) {
+      if (input_len == 0) {
+        if (next == num_hashers) {
+          break;
+        }
+        hasher = hashers[next];
+        input = (const uint8_t *)inputs[next];
+        input_len = input_lens[next];
+        next += 1;
+        planned = 0;
+        if (input_len > long_len) {
+          hasher_update(&hasher->state, hasher->cv_stack, input, input_len,
+                        DEFAULT_EXECUTOR);
+          input_len = 0;
+        } else if (input_len > 0) {
+          hasher_lanes_head(&hasher->state, hasher->cv_stack, &input,
+                            &input_len);
+        }
+        continue;
+      }
+      hasher_lane_plan(&hasher->state, planned, &input, &input_len,
+                       &lanes[num_lanes], &tail_lens[num_lanes]);
+      owners[num_lanes] = hasher;
+      num_lanes += 1;
+      planned += 1;
+    }
+    if (num_lanes == 0) {
+      return;
+    }
+    backend->compress_lanes(lanes, num_lanes);
+    for (size_t i = 0; i < num_lanes; i++) {
+      hasher_lane_finish(&owners[i]->state, owners[i]->cv_stack, &lanes[i],
+                         tail_lens[i]);
+    }
+  }
+}
+
+static void hasher_finalize_seek(const blake3_hasher_state *self,
+                                 const uint8_t *cv_stack, uint64_t seek,
                                  uint8_t *out, size_t out_len) {
   // Explicitly checking for zero avoids causing UB by passing a null pointer
   // to memcpy. This comes up in practice with things like:
@@ -661,20 +1126,475 @@ void blake3_hasher_finalize_seek(const blake3_hasher *self, uint64_t seek,
   } else {
     // There are always at least 2 CVs in the stack in this case.
     cvs_remaining = self->cv_stack_len - 2;
-    output = parent_output(&self->cv_stack[cvs_remaining * 32], self->key,
+    output = parent_output(&cv_stack[cvs_remaining * 32], self->key,
                            self->chunk.flags);
   }
   while (cvs_remaining > 0) {
     cvs_remaining -= 1;
     uint8_t parent_block[BLAKE3_BLOCK_LEN];
-    memcpy(parent_block, &self->cv_stack[cvs_remaining * 32], 32);
+    memcpy(parent_block, &cv_stack[cvs_remaining * 32], 32);
     output_chaining_value(&output, &parent_block[32]);
     output = parent_output(parent_block, self->key, self->chunk.flags);
   }
   output_root_bytes(&output, seek, out, out_len);
 }
 
-void blake3_hasher_reset(blake3_hasher *self) {
+void blake3_hasher_finalize(const blake3_hasher *self, uint8_t *out,
+                            size_t out_len) {
+  hasher_finalize_seek(&self->state, self->cv_stack, 0, out, out_len);
+}
+
+void blake3_hasher_finalize_seek(const blake3_hasher *self, uint64_t seek,
+                                 uint8_t *out, size_t out_len) {
+  hasher_finalize_seek(&self->state, self->cv_stack, seek, out, out_len);
+}
+
+INLINE void hasher_reset(blake3_hasher_state *self) {
   chunk_state_reset(&self->chunk, self->key, 0);
   self->cv_stack_len = 0;
 }
+
+void blake3_hasher_reset(blake3_hasher *self) { hasher_reset(&self->state); }
+
+// Only the first cv_stack_len entries of the stack are live, and for short
+// inputs that's usually none of them, so copy just those rather than the
+// whole struct.
+INLINE void hasher_fork(blake3_hasher_state *dst, uint8_t *dst_cv_stack,
+                        const blake3_hasher_state *src,
+                        const uint8_t *src_cv_stack) {
+  if (dst == src) {
+    return;
+  }
+  *dst = *src;
+  memcpy(dst_cv_stack, src_cv_stack,
+         (size_t)src->cv_stack_len * BLAKE3_OUT_LEN);
+}
+
+void blake3_hasher_fork(blake3_hasher *dst, const blake3_hasher *src) {
+  hasher_fork(&dst->state, dst->cv_stack, &src->state, src->cv_stack);
+}
+
+void blake3_compact_hasher_init(blake3_compact_hasher *self) {
+  hasher_init_base(&self->state, IV, 0);
+}
+
+void blake3_compact_hasher_init_keyed(blake3_compact_hasher *self,
+                                      const uint8_t key[BLAKE3_KEY_LEN]) {
+  uint32_t key_words[8];
+  load_key_words(key, key_words);
+  hasher_init_base(&self->state, key_words, KEYED_HASH);
+}
+
+void blake3_compact_hasher_init_derive_key(blake3_compact_hasher *self,
+                                           const char *context) {
+  blake3_compact_hasher_init_derive_key_raw(self, context, strlen(context));
+}
+
+void blake3_compact_hasher_init_derive_key_raw(blake3_compact_hasher *self,
+                                               const void *context,
+                                               size_t context_len) {
+  uint32_t context_key_words[8];
+  hasher_context_key(context, context_len, context_key_words);
+  hasher_init_base(&self->state, context_key_words, DERIVE_KEY_MATERIAL);
+}
+
+void blake3_compact_hasher_init_prepared(blake3_compact_hasher *self,
+                                         const blake3_prepared_key *key) {
+  hasher_init_base(&self->state, key->key, key->flags);
+}
+
+int blake3_compact_hasher_update(blake3_compact_hasher *self,
+                                 const void *input, size_t input_len) {
+  // The CV stack only has room for inputs up to BLAKE3_COMPACT_MAX_LEN, so
+  // refuse anything that would go past it.
+  uint64_t len_so_far = self->state.chunk.chunk_counter * BLAKE3_CHUNK_LEN +
+                        (uint64_t)chunk_state_len(&self->state.chunk);
+  if ((uint64_t)input_len > BLAKE3_COMPACT_MAX_LEN - len_so_far) {
+    return -1;
+  }
+  hasher_update(&self->state, self->cv_stack, input, input_len,
+                DEFAULT_EXECUTOR);
+  return 0;
+}
+
+void blake3_compact_hasher_finalize(const blake3_compact_hasher *self,
+                                    uint8_t *out, size_t out_len) {
+  hasher_finalize_seek(&self->state, self->cv_stack, 0, out, out_len);
+}
+
+void blake3_compact_hasher_finalize_seek(const blake3_compact_hasher *self,
+                                         uint64_t seek, uint8_t *out,
+                                         size_t out_len) {
+  hasher_finalize_seek(&self->state, self->cv_stack, seek, out, out_len);
+}
+
+void blake3_compact_hasher_reset(blake3_compact_hasher *self) {
+  hasher_reset(&self->state);
+}
+
+void blake3_compact_hasher_fork(blake3_compact_hasher *dst,
+                                const blake3_compact_hasher *src) {
+  hasher_fork(&dst->state, dst->cv_stack, &src->state, src->cv_stack);
+}
+
+int blake3_subtree_cv(const void *input, size_t input_len,
+                      uint64_t chunk_counter, uint8_t cv[BLAKE3_OUT_LEN]) {
+  // The subtree must be non-empty, and chunk_counter must be a multiple of
+  // its size in chunks, rounded up to a power of 2. Only subtrees on the right
+  // edge of the tree can be partial, and this can't tell whether that's so.
+  if (input_len == 0) {
+    return -1;
+  }
+  uint64_t chunks = ((uint64_t)input_len - 1) / BLAKE3_CHUNK_LEN + 1;
+  uint64_t span = round_down_to_power_of_2(chunks);
+  if (span < chunks) {
+    span *= 2;
+  }
+  if ((chunk_counter & (span - 1)) != 0) {
+    return -1;
+  }
+  output_t output;
+  if (input_len <= BLAKE3_CHUNK_LEN) {
+    blake3_chunk_state chunk_state;
+    chunk_state_init(&chunk_state, IV, 0);
+    chunk_state.chunk_counter = chunk_counter;
+    chunk_state_update(&chunk_state, (const uint8_t *)input, input_len);
+    output = chunk_state_output(&chunk_state);
+  } else {
+    uint8_t cv_pair[2 * BLAKE3_OUT_LEN];
+    compress_subtree_to_parent_node((const uint8_t *)input, input_len, IV,
+                                    chunk_counter, 0, cv_pair,
+                                    DEFAULT_EXECUTOR);
+    output = parent_output(cv_pair, IV, 0);
+  }
+  output_chaining_value(&output, cv);
+  return 0;
+}
+
+void blake3_parent_cv(const uint8_t left_cv[BLAKE3_OUT_LEN],
+                      const uint8_t right_cv[BLAKE3_OUT_LEN],
+                      uint8_t cv[BLAKE3_OUT_LEN]) {
+  uint8_t block[BLAKE3_BLOCK_LEN];
+  memcpy(block, left_cv, BLAKE3_OUT_LEN);
+  memcpy(&block[BLAKE3_OUT_LEN], right_cv, BLAKE3_OUT_LEN);
+  output_t output = parent_output(block, IV, 0);
+  output_chaining_value(&output, cv);
+}
+
+void blake3_parent_root(const uint8_t left_cv[BLAKE3_OUT_LEN],
+                        const uint8_t right_cv[BLAKE3_OUT_LEN], uint8_t *out,
+                        size_t out_len) {
+  if (out_len == 0) {
+    return;
+  }
+  uint8_t block[BLAKE3_BLOCK_LEN];
+  memcpy(block, left_cv, BLAKE3_OUT_LEN);
+  memcpy(&block[BLAKE3_OUT_LEN], right_cv, BLAKE3_OUT_LEN);
+  output_t output = parent_output(block, IV, 0);
+  output_root_bytes(&output, 0, out, out_len);
+}
+
+// Messages in a batch are queued by length class and hashed up to
+// MAX_SIMD_DEGREE at a time with blake3_hash_many. A class is the number of
+// whole blocks before the final block, plus whether the final block is
+// partial. Since hash_many only compresses full blocks, a message with a
+// partial (or empty) final block gets that block compressed on its own
+// afterwards.
+#define BATCH_CLASSES (BLAKE3_CHUNK_LEN / BLAKE3_BLOCK_LEN + 1)
+
+typedef struct {
+  size_t indices[MAX_SIMD_DEGREE];
+  size_t len;
+} batch_queue;
+
+static void batch_queue_flush(batch_queue *queue, const void *const *inputs,
+                              const size_t *input_lens, size_t full_blocks,
+                              bool partial, const uint32_t key[8],
+                              uint8_t flags, uint8_t *out) {
+  const uint8_t *inputs_array[MAX_SIMD_DEGREE];
+  uint8_t cvs[MAX_SIMD_DEGREE * BLAKE3_OUT_LEN];
+  if (full_blocks > 0) {
+    for (size_t i = 0; i < queue->len; i++) {
+      inputs_array[i] = (const uint8_t *)inputs[queue->indices[i]];
+    }
+    blake3_hash_many(inputs_array, queue->len, full_blocks, key, 0, false,
+                     flags, CHUNK_START, partial ? 0 : CHUNK_END | ROOT, cvs);
+  }
+  for (size_t i = 0; i < queue->len; i++) {
+    size_t index = queue->indices[i];
+    uint8_t *digest = &out[index * BLAKE3_OUT_LEN];
+    if (!partial) {
+      memcpy(digest, &cvs[i * BLAKE3_OUT_LEN], BLAKE3_OUT_LEN);
+      continue;
+    }
+    uint32_t cv[8];
+    uint8_t block_flags = flags | CHUNK_END | ROOT;
+    if (full_blocks > 0) {
+      load_key_words(&cvs[i * BLAKE3_OUT_LEN], cv);
+    } else {
+      memcpy(cv, key, BLAKE3_KEY_LEN);
+      block_flags |= CHUNK_START;
+    }
+    size_t block_len = input_lens[index] - full_blocks * BLAKE3_BLOCK_LEN;
+    uint8_t block[BLAKE3_BLOCK_LEN] = {0};
+    // An empty message may come with a NULL pointer.
+    if (block_len > 0) {
+      memcpy(block,
+             (const uint8_t *)inputs[index] + full_blocks * BLAKE3_BLOCK_LEN,
+             block_len);
+    }
+    blake3_compress_in_place(cv, block, (uint8_t)block_len, 0, block_flags);
+    store_cv_words(digest, cv);
+  }
+  queue->len = 0;
+}
+
+void blake3_hash_batch(const void *const *inputs, const size_t *input_lens,
+                       size_t num_inputs, uint8_t *out) {
+  batch_queue queues[2][BATCH_CLASSES];
+  for (size_t i = 0; i < BATCH_CLASSES; i++) {
+    queues[0][i].len = 0;
+    queues[1][i].len = 0;
+  }
+  for (size_t index = 0; index < num_inputs; index++) {
+    size_t len = input_lens[index];
+    if (len > BLAKE3_CHUNK_LEN) {
+      blake3_hasher hasher;
+      blake3_hasher_init(&hasher);
+      blake3_hasher_update(&hasher, inputs[index], len);
+      blake3_hasher_finalize(&hasher, &out[index * BLAKE3_OUT_LEN],
+                             BLAKE3_OUT_LEN);
+      continue;
+    }
+    size_t full_blocks = len / BLAKE3_BLOCK_LEN;
+    bool partial = len == 0 || len % BLAKE3_BLOCK_LEN != 0;
+    batch_queue *queue = &queues[partial][full_blocks];
+    queue->indices[queue->len++] = index;
+    if (queue->len == MAX_SIMD_DEGREE) {
+      batch_queue_flush(queue, inputs, input_lens, full_blocks, partial, IV, 0,
+                        out);
+    }
+  }
+  for (size_t i = 0; i < BATCH_CLASSES; i++) {
+    if (queues[0][i].len > 0) {
+      batch_queue_flush(&queues[0][i], inputs, input_lens, i, false, IV, 0,
+                        out);
+    }
+    if (queues[1][i].len > 0) {
+      batch_queue_flush(&queues[1][i], inputs, input_lens, i, true, IV, 0,
+                        out);
+    }
+  }
+}
+
+// The outboard encoding stores every parent node above the chunk group level
+// in pre-order, after an 8-byte little-endian content length. Each parent node
+// is the concatenated chaining values of its two children, so a reader that
+// has verified a node knows the expected chaining values of both halves.
+// Within a chunk group the tree shape is the usual one, and all groups except
+// the last are exactly BLAKE3_OUTBOARD_GROUP_LEN bytes.
+
+uint64_t blake3_outboard_size(uint64_t content_len) {
+  uint64_t groups = 1;
+  if (content_len > BLAKE3_OUTBOARD_GROUP_LEN) {
+    groups = (content_len + BLAKE3_OUTBOARD_GROUP_LEN - 1) /
+             BLAKE3_OUTBOARD_GROUP_LEN;
+  }
+  return 8 + (groups - 1) * BLAKE3_BLOCK_LEN;
+}
+
+// As left_len(), but for content lengths that might not fit in a size_t.
+INLINE uint64_t outboard_left_len(uint64_t content_len) {
+  uint64_t full_chunks = (content_len - 1) / BLAKE3_CHUNK_LEN;
+  return round_down_to_power_of_2(full_chunks) * BLAKE3_CHUNK_LEN;
+}
+
+// Compute the chaining value of a chunk group, or the root hash if the group
+// is the whole input.
+static void outboard_group_cv(const uint8_t *input, size_t input_len,
+                              uint64_t chunk_counter, bool is_root,
+                              uint8_t cv[BLAKE3_OUT_LEN]) {
+  output_t output;
+  if (input_len <= BLAKE3_CHUNK_LEN) {
+    blake3_chunk_state chunk_state;
+    chunk_state_init(&chunk_state, IV, 0);
+    chunk_state.chunk_counter = chunk_counter;
+    if (input_len > 0) {
+      chunk_state_update(&chunk_state, input, input_len);
+    }
+    output = chunk_state_output(&chunk_state);
+  } else {
+    uint8_t cv_pair[2 * BLAKE3_OUT_LEN];
+    compress_subtree_to_parent_node(input, input_len, IV, chunk_counter, 0,
+                                    cv_pair, NULL);
+    output = parent_output(cv_pair, IV, 0);
+  }
+  if (is_root) {
+    output.flags |= ROOT;
+  }
+  output_chaining_value(&output, cv);
+}
+
+// Compute the chaining value of a parent node, or the root hash.
+INLINE void outboard_parent_cv(const uint8_t node[BLAKE3_BLOCK_LEN],
+                               bool is_root, uint8_t cv[BLAKE3_OUT_LEN]) {
+  output_t output = parent_output(node, IV, 0);
+  if (is_root) {
+    output.flags |= ROOT;
+  }
+  output_chaining_value(&output, cv);
+}
+
+// Write the parent nodes of a subtree to *outboard in pre-order, advancing
+// it, and compute the subtree's chaining value.
+static void outboard_encode_subtree(const uint8_t *input, size_t input_len,
+                                    uint64_t chunk_counter, bool is_root,
+                                    uint8_t **outboard,
+                                    uint8_t cv[BLAKE3_OUT_LEN]) {
+  if (input_len <= BLAKE3_OUTBOARD_GROUP_LEN) {
+    outboard_group_cv(input, input_len, chunk_counter, is_root, cv);
+    return;
+  }
+  uint8_t *node = *outboard;
+  *outboard += BLAKE3_BLOCK_LEN;
+  size_t left_input_len = left_len(input_len);
+  outboard_encode_subtree(input, left_input_len, chunk_counter, false,
+                          outboard, node);
+  outboard_encode_subtree(&input[left_input_len], input_len - left_input_len,
+                          chunk_counter + left_input_len / BLAKE3_CHUNK_LEN,
+                          false, outboard, &node[BLAKE3_OUT_LEN]);
+  outboard_parent_cv(node, is_root, cv);
+}
+
+void blake3_outboard_encode(const void *input, size_t input_len,
+                            uint8_t *outboard, uint8_t hash[BLAKE3_OUT_LEN]) {
+  for (size_t i = 0; i < 8; i++) {
+    outboard[i] = (uint8_t)((uint64_t)input_len >> (8 * i));
+  }
+  outboard += 8;
+  outboard_encode_subtree((const uint8_t *)input, input_len, 0, true,
+                          &outboard, hash);
+}
+
+int blake3_outboard_decoder_init(blake3_outboard_decoder *self,
+                                 const uint8_t hash[BLAKE3_OUT_LEN],
+                                 const uint8_t *outboard,
+                                 size_t outboard_len) {
+  if (outboard_len < 8) {
+    return -1;
+  }
+  self->content_len = 0;
+  for (size_t i = 0; i < 8; i++) {
+    self->content_len |= (uint64_t)outboard[i] << (8 * i);
+  }
+  if (blake3_outboard_size(self->content_len) != outboard_len) {
+    return -1;
+  }
+  self->outboard = outboard + 8;
+  self->outboard_len = outboard_len - 8;
+  self->position = 0;
+  memcpy(self->cv_stack, hash, BLAKE3_OUT_LEN);
+  self->len_stack[0] = self->content_len;
+  self->stack_len = 1;
+  self->failed = 0;
+  self->buf_len = 0;
+  return 0;
+}
+
+// The top of the stack is the subtree that starts at the current position,
+// and the entries below it are the right siblings still to come. Split the
+// top subtree until it is a single chunk group, verifying each parent node on
+// the way down against the chaining value it was expected to have.
+static bool outboard_decoder_descend(blake3_outboard_decoder *self) {
+  for (;;) {
+    size_t top = (size_t)self->stack_len - 1;
+    uint64_t len = self->len_stack[top];
+    if (len <= BLAKE3_OUTBOARD_GROUP_LEN) {
+      return true;
+    }
+    if (self->outboard_len < BLAKE3_BLOCK_LEN) {
+      return false;
+    }
+    const uint8_t *node = self->outboard;
+    uint8_t cv[BLAKE3_OUT_LEN];
+    outboard_parent_cv(node, self->position == 0 && len == self->content_len,
+                       cv);
+    if (memcmp(cv, &self->cv_stack[top * BLAKE3_OUT_LEN], BLAKE3_OUT_LEN) !=
+        0) {
+      return false;
+    }
+    self->outboard += BLAKE3_BLOCK_LEN;
+    self->outboard_len -= BLAKE3_BLOCK_LEN;
+    uint64_t left = outboard_left_len(len);
+    memcpy(&self->cv_stack[top * BLAKE3_OUT_LEN], &node[BLAKE3_OUT_LEN],
+           BLAKE3_OUT_LEN);
+    self->len_stack[top] = len - left;
+    memcpy(&self->cv_stack[(top + 1) * BLAKE3_OUT_LEN], node, BLAKE3_OUT_LEN);
+    self->len_stack[top + 1] = left;
+    self->stack_len += 1;
+  }
+}
+
+// Verify the chunk group on top of the stack and pop it.
+static bool outboard_decoder_verify(blake3_outboard_decoder *self,
+                                    const uint8_t *group, size_t group_len) {
+  size_t top = (size_t)self->stack_len - 1;
+  uint8_t cv[BLAKE3_OUT_LEN];
+  outboard_group_cv(group, group_len, self->position / BLAKE3_CHUNK_LEN,
+                    self->position == 0 && group_len == self->content_len, cv);
+  if (memcmp(cv, &self->cv_stack[top * BLAKE3_OUT_LEN], BLAKE3_OUT_LEN) != 0) {
+    return false;
+  }
+  self->position += group_len;
+  self->stack_len -= 1;
+  self->buf_len = 0;
+  return true;
+}
+
+int blake3_outboard_decoder_update(blake3_outboard_decoder *self,
+                                   const void *input, size_t input_len) {
+  const uint8_t *input_bytes = (const uint8_t *)input;
+  while (input_len > 0 && !self->failed) {
+    // Input past the end of the content can't be verified.
+    if (self->stack_len == 0 || !outboard_decoder_descend(self)) {
+      self->failed = 1;
+      break;
+    }
+    size_t group_len = (size_t)self->len_stack[self->stack_len - 1];
+    // Whole groups are verified in place, and anything else is buffered
+    // until its group is complete.
+    if (self->buf_len == 0 && input_len >= group_len) {
+      if (!outboard_decoder_verify(self, input_bytes, group_len)) {
+        self->failed = 1;
+      }
+      input_bytes += group_len;
+      input_len -= group_len;
+      continue;
+    }
+    size_t take = group_len - self->buf_len;
+    if (take > input_len) {
+      take = input_len;
+    }
+    memcpy(&self->buf[self->buf_len], input_bytes, take);
+    self->buf_len += take;
+    input_bytes += take;
+    input_len -= take;
+    if (self->buf_len == group_len &&
+        !outboard_decoder_verify(self, self->buf, group_len)) {
+      self->failed = 1;
+    }
+  }
+  return self->failed ? -1 : 0;
+}
+
+int blake3_outboard_decoder_finalize(blake3_outboard_decoder *self) {
+  // The empty input is a single empty group, which update() never sees.
+  if (!self->failed && self->content_len == 0 && self->stack_len == 1 &&
+      !outboard_decoder_verify(self, self->buf, 0)) {
+    self->failed = 1;
+  }
+  if (self->failed || self->stack_len != 0) {
+    return -1;
+  }
+  return 0;
+}
@@ -36,6 +36,10 @@ extern "C" {
 #define BLAKE3_BLOCK_LEN 64
 #define BLAKE3_CHUNK_LEN 1024
 #define BLAKE3_MAX_DEPTH 54
+#define BLAKE3_OUTBOARD_GROUP_LEN (16 * BLAKE3_CHUNK_LEN)
+#define BLAKE3_COMPACT_MAX_DEPTH 22
+#define BLAKE3_COMPACT_MAX_LEN \
+  ((uint64_t)BLAKE3_CHUNK_LEN << BLAKE3_COMPACT_MAX_DEPTH)
 
 // This struct is a private implementation detail. It has to be here because
 // it's part of blake3_hasher below.
@@ -48,10 +52,17 @@ typedef struct {
   uint8_t flags;
 } blake3_chunk_state;
 
+// This struct is a private implementation detail too. It's the part of
+// blake3_hasher and blake3_compact_hasher that doesn't depend on the maximum
+// input length.
 typedef struct {
   uint32_t key[8];
   blake3_chunk_state chunk;
   uint8_t cv_stack_len;
+} blake3_hasher_state;
+
+typedef struct {
+  blake3_hasher_state state;
   // The stack size is MAX_DEPTH + 1 because we do lazy merging. For example,
   // with 7 chunks, we have 3 entries in the stack. Adding an 8th chunk
   // requires a 4th entry, rather than merging everything down to 1, because we
@@ -60,20 +71,136 @@ typedef struct {
   uint8_t cv_stack[(BLAKE3_MAX_DEPTH + 1) * BLAKE3_OUT_LEN];
 } blake3_hasher;
 
+// A hasher for inputs of at most BLAKE3_COMPACT_MAX_LEN (4 GiB) in total, which
+// only needs room for BLAKE3_COMPACT_MAX_DEPTH + 1 entries in its CV stack.
+typedef struct {
+  blake3_hasher_state state;
+  uint8_t cv_stack[(BLAKE3_COMPACT_MAX_DEPTH + 1) * BLAKE3_OUT_LEN];
+} blake3_compact_hasher;
+
+// A key, or a derived key's context string, prepared for initializing any
+// number of hashers. Its fields are private.
+typedef struct {
+  uint32_t key[8];
+  uint8_t flags;
+} blake3_prepared_key;
+
+// A caller-provided executor for blake3_hasher_update_parallel(). spawn()
+// schedules task(arg) to run and returns a non-NULL handle for it, or returns
+// NULL to decline, in which case the task runs on the calling thread instead.
+// join() is called exactly once for each handle, and must not return until
+// the task has finished.
+typedef struct {
+  void *(*spawn)(void *ctx, void (*task)(void *), void *arg);
+  void (*join)(void *ctx, void *handle);
+  void *ctx;
+} blake3_executor;
+
+// The state of a streaming outboard verifier. Like blake3_hasher, its fields
+// are private. The stack holds the expected chaining value and length of the
+// subtree at the current position, and of each right sibling still to come.
+typedef struct {
+  const uint8_t *outboard;
+  size_t outboard_len;
+  uint64_t content_len;
+  uint64_t position;
+  uint64_t len_stack[BLAKE3_MAX_DEPTH + 1];
+  uint8_t cv_stack[(BLAKE3_MAX_DEPTH + 1) * BLAKE3_OUT_LEN];
+  uint8_t stack_len;
+  uint8_t failed;
+  size_t buf_len;
+  uint8_t buf[BLAKE3_OUTBOARD_GROUP_LEN];
+} blake3_outboard_decoder;
+
 BLAKE3_API const char *blake3_version(void);
+BLAKE3_API const char *blake3_get_backend(void);
+BLAKE3_API int blake3_set_backend(const char *name);
 BLAKE3_API void blake3_hasher_init(blake3_hasher *self);
 BLAKE3_API void blake3_hasher_init_keyed(blake3_hasher *self,
                                          const uint8_t key[BLAKE3_KEY_LEN]);
 BLAKE3_API void blake3_hasher_init_derive_key(blake3_hasher *self, const char *context);
 BLAKE3_API void blake3_hasher_init_derive_key_raw(blake3_hasher *self, const void *context,
                                                   size_t context_len);
+BLAKE3_API void blake3_prepared_key_init_keyed(
+    blake3_prepared_key *self, const uint8_t key[BLAKE3_KEY_LEN]);
+BLAKE3_API void blake3_prepared_key_init_derive_key(blake3_prepared_key *self,
+                                                   const char *context);
+BLAKE3_API void blake3_prepared_key_init_derive_key_raw(
+    blake3_prepared_key *self, const void *context, size_t context_len);
+BLAKE3_API void blake3_hash(const void *input, size_t input_len, uint8_t *out,
+                            size_t out_len);
+BLAKE3_API void blake3_hash_keyed(const uint8_t key[BLAKE3_KEY_LEN],
+                                  const void *input, size_t input_len,
+                                  uint8_t *out, size_t out_len);
+BLAKE3_API void blake3_hash_derive_key(const char *context, const void *input,
+                                       size_t input_len, uint8_t *out,
+                                       size_t out_len);
+BLAKE3_API void blake3_hash_prepared(const blake3_prepared_key *key,
+                                     const void *input, size_t input_len,
+                                     uint8_t *out, size_t out_len);
+BLAKE3_API void blake3_hasher_init_prepared(blake3_hasher *self,
+                                            const blake3_prepared_key *key);
 BLAKE3_API void blake3_hasher_update(blake3_hasher *self, const void *input,
                                      size_t input_len);
+BLAKE3_API void blake3_hasher_update_parallel(blake3_hasher *self,
+                                              const void *input,
+                                              size_t input_len,
+                                              const blake3_executor *executor);
+BLAKE3_API void blake3_hasher_update_many(blake3_hasher *const *hashers,
+                                          const void *const *inputs,
+                                          const size_t *input_lens,
+                                          size_t num_hashers);
 BLAKE3_API void blake3_hasher_finalize(const blake3_hasher *self, uint8_t *out,
                                        size_t out_len);
 BLAKE3_API void blake3_hasher_finalize_seek(const blake3_hasher *self, uint64_t seek,
                                             uint8_t *out, size_t out_len);
 BLAKE3_API void blake3_hasher_reset(blake3_hasher *self);
+BLAKE3_API void blake3_hasher_fork(blake3_hasher *dst,
+                                   const blake3_hasher *src);
+BLAKE3_API void blake3_compact_hasher_init(blake3_compact_hasher *self);
+BLAKE3_API void blake3_compact_hasher_init_keyed(
+    blake3_compact_hasher *self, const uint8_t key[BLAKE3_KEY_LEN]);
+BLAKE3_API void blake3_compact_hasher_init_derive_key(
+    blake3_compact_hasher *self, const char *context);
+BLAKE3_API void blake3_compact_hasher_init_derive_key_raw(
+    blake3_compact_hasher *self, const void *context, size_t context_len);
+BLAKE3_API void blake3_compact_hasher_init_prepared(
+    blake3_compact_hasher *self, const blake3_prepared_key *key);
+BLAKE3_API int blake3_compact_hasher_update(blake3_compact_hasher *self,
+                                            const void *input,
+                                            size_t input_len);
+BLAKE3_API void blake3_compact_hasher_finalize(
+    const blake3_compact_hasher *self, uint8_t *out, size_t out_len);
+BLAKE3_API void blake3_compact_hasher_finalize_seek(
+    const blake3_compact_hasher *self, uint64_t seek, uint8_t *out,
+    size_t out_len);
+BLAKE3_API void blake3_compact_hasher_reset(blake3_compact_hasher *self);
+BLAKE3_API void blake3_compact_hasher_fork(blake3_compact_hasher *dst,
+                                           const blake3_compact_hasher *src);
+BLAKE3_API void blake3_hash_batch(const void *const *inputs,
+                                  const size_t *input_lens, size_t num_inputs,
+                                  uint8_t *out);
+BLAKE3_API int blake3_subtree_cv(const void *input, size_t input_len,
+                                 uint64_t chunk_counter,
+                                 uint8_t cv[BLAKE3_OUT_LEN]);
+BLAKE3_API void blake3_parent_cv(const uint8_t left_cv[BLAKE3_OUT_LEN],
+                                 const uint8_t right_cv[BLAKE3_OUT_LEN],
+                                 uint8_t cv[BLAKE3_OUT_LEN]);
+BLAKE3_API void blake3_parent_root(const uint8_t left_cv[BLAKE3_OUT_LEN],
+                                   const uint8_t right_cv[BLAKE3_OUT_LEN],
+                                   uint8_t *out, size_t out_len);
+BLAKE3_API uint64_t blake3_outboard_size(uint64_t content_len);
+BLAKE3_API void blake3_outboard_encode(const void *input, size_t input_len,
+                                       uint8_t *outboard,
+                                       uint8_t hash[BLAKE3_OUT_LEN]);
+BLAKE3_API int blake3_outboard_decoder_init(blake3_outboard_decoder *self,
+                                            const uint8_t hash[BLAKE3_OUT_LEN],
+                                            const uint8_t *outboard,
+                                            size_t outboard_len);
+BLAKE3_API int blake3_outboard_decoder_update(blake3_outboard_decoder *self,
+                                              const void *input,
+                                              size_t input_len);
+BLAKE3_API int blake3_outboard_decoder_finalize(blake3_outboard_decoder *self);
 
 #ifdef __cplusplus
 }
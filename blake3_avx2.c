@@ -324,3 +324,44 @@ void blake3_hash_many_avx2(const uint8_t *const *inputs, size_t num_inputs,
                             out);
 #endif
 }
+
+// Compute 8 consecutive 64-byte blocks of extended output from a single root
+// node, with counters counter through counter+7.
+void blake3_xof8_avx2(const uint32_t cv[8],
+                      const uint8_t block[BLAKE3_BLOCK_LEN],
+                      uint8_t block_len, uint64_t counter, uint8_t flags,
+                      uint8_t out[DEGREE * 64]) {
+  __m256i msg_vecs[16];
+  for (size_t i = 0; i < 16; i++) {
+    msg_vecs[i] = set1(load32(&block[i * 4]));
+  }
+  __m256i counter_low_vec, counter_high_vec;
+  load_counters(counter, true, &counter_low_vec, &counter_high_vec);
+
+  __m256i v[16] = {
+      set1(cv[0]),     set1(cv[1]),      set1(cv[2]),     set1(cv[3]),
+      set1(cv[4]),     set1(cv[5]),      set1(cv[6]),     set1(cv[7]),
+      set1(IV[0]),     set1(IV[1]),      set1(IV[2]),     set1(IV[3]),
+      counter_low_vec, counter_high_vec, set1(block_len), set1(flags),
+  };
+  round_fn(v, msg_vecs, 0);
+  round_fn(v, msg_vecs, 1);
+  round_fn(v, msg_vecs, 2);
+  round_fn(v, msg_vecs, 3);
+  round_fn(v, msg_vecs, 4);
+  round_fn(v, msg_vecs, 5);
+  round_fn(v, msg_vecs, 6);
+  for (size_t i = 0; i < 8; i++) {
+    v[i] = xorv(v[i], v[i + 8]);
+    v[i + 8] = xorv(v[i + 8], set1(cv[i]));
+  }
+
+  // After transposing each half, v[i] and v[i + 8] hold the two halves of
+  // output block i.
+  transpose_vecs(&v[0]);
+  transpose_vecs(&v[8]);
+  for (size_t i = 0; i < DEGREE; i++) {
+    storeu(v[i], &out[i * 64 + 0 * sizeof(__m256i)]);
+    storeu(v[i + 8], &out[i * 64 + 1 * sizeof(__m256i)]);
+  }
+}
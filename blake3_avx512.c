@@ -1218,3 +1218,47 @@ void blake3_hash_many_avx512(const uint8_t *const *inputs, size_t num_inputs,
     out = &out[BLAKE3_OUT_LEN];
   }
 }
+
+/*
+ * ----------------------------------------------------------------------------
+ * xof16_avx512
+ * ----------------------------------------------------------------------------
+ */
+
+// Compute 16 consecutive 64-byte blocks of extended output from a single
+// root node, with counters counter through counter+15.
+void blake3_xof16_avx512(const uint32_t cv[8],
+                         const uint8_t block[BLAKE3_BLOCK_LEN],
+                         uint8_t block_len, uint64_t counter, uint8_t flags,
+                         uint8_t out[16 * 64]) {
+  __m512i msg_vecs[16];
+  for (size_t i = 0; i < 16; i++) {
+    msg_vecs[i] = set1_512(load32(&block[i * 4]));
+  }
+  __m512i counter_low_vec, counter_high_vec;
+  load_counters16(counter, true, &counter_low_vec, &counter_high_vec);
+
+  __m512i v[16] = {
+      set1_512(cv[0]), set1_512(cv[1]),  set1_512(cv[2]),        set1_512(cv[3]),
+      set1_512(cv[4]), set1_512(cv[5]),  set1_512(cv[6]),        set1_512(cv[7]),
+      set1_512(IV[0]), set1_512(IV[1]),  set1_512(IV[2]),        set1_512(IV[3]),
+      counter_low_vec, counter_high_vec, set1_512(block_len),    set1_512(flags),
+  };
+  round_fn16(v, msg_vecs, 0);
+  round_fn16(v, msg_vecs, 1);
+  round_fn16(v, msg_vecs, 2);
+  round_fn16(v, msg_vecs, 3);
+  round_fn16(v, msg_vecs, 4);
+  round_fn16(v, msg_vecs, 5);
+  round_fn16(v, msg_vecs, 6);
+  for (size_t i = 0; i < 8; i++) {
+    v[i] = xor_512(v[i], v[i + 8]);
+    v[i + 8] = xor_512(v[i + 8], set1_512(cv[i]));
+  }
+
+  // Each row of the transposed state is one full output block.
+  transpose_vecs_512(v);
+  for (size_t i = 0; i < 16; i++) {
+    _mm512_storeu_si512((__m512i *)&out[i * 64], v[i]);
+  }
+}
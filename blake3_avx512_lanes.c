@@ -0,0 +1,222 @@
+#include "blake3_impl.h"
+
+#include <immintrin.h>
+
+// The AVX-512 kernel behind compress_lanes. Each of the 16 lanes is a 32-bit
+// element with its own chaining value, counter, flags and input, unlike
+// hash_many, where every input starts from the same key and counter. That
+// lets blake3_hasher_update_many() put unrelated hashers side by side. This
+// file is intrinsics only, and it's built for both x86 configurations.
+
+#define LANES 16
+
+INLINE __m512i add_512(__m512i a, __m512i b) { return _mm512_add_epi32(a, b); }
+
+INLINE __m512i xor_512(__m512i a, __m512i b) { return _mm512_xor_si512(a, b); }
+
+INLINE __m512i set1_512(uint32_t x) { return _mm512_set1_epi32((int32_t)x); }
+
+INLINE __m512i loadu_words(const uint32_t src[LANES]) {
+  return _mm512_loadu_si512((const void *)src);
+}
+
+INLINE __m512i rot16_512(__m512i x) { return _mm512_ror_epi32(x, 16); }
+
+INLINE __m512i rot12_512(__m512i x) { return _mm512_ror_epi32(x, 12); }
+
+INLINE __m512i rot8_512(__m512i x) { return _mm512_ror_epi32(x, 8); }
+
+INLINE __m512i rot7_512(__m512i x) { return _mm512_ror_epi32(x, 7); }
+
+INLINE void g(__m512i *v, size_t a, size_t b, size_t c, size_t d, __m512i x,
+              __m512i y) {
+  v[a] = add_512(add_512(v[a], v[b]), x);
+  v[d] = rot16_512(xor_512(v[d], v[a]));
+  v[c] = add_512(v[c], v[d]);
+  v[b] = rot12_512(xor_512(v[b], v[c]));
+  v[a] = add_512(add_512(v[a], v[b]), y);
+  v[d] = rot8_512(xor_512(v[d], v[a]));
+  v[c] = add_512(v[c], v[d]);
+  v[b] = rot7_512(xor_512(v[b], v[c]));
+}
+
+INLINE void round_fn(__m512i v[16], const __m512i m[16], size_t round) {
+  const uint8_t *schedule = MSG_SCHEDULE[round];
+
+  // Mix the columns.
+  g(v, 0, 4, 8, 12, m[schedule[0]], m[schedule[1]]);
+  g(v, 1, 5, 9, 13, m[schedule[2]], m[schedule[3]]);
+  g(v, 2, 6, 10, 14, m[schedule[4]], m[schedule[5]]);
+  g(v, 3, 7, 11, 15, m[schedule[6]], m[schedule[7]]);
+
+  // Mix the diagonals.
+  g(v, 0, 5, 10, 15, m[schedule[8]], m[schedule[9]]);
+  g(v, 1, 6, 11, 12, m[schedule[10]], m[schedule[11]]);
+  g(v, 2, 7, 8, 13, m[schedule[12]], m[schedule[13]]);
+  g(v, 3, 4, 9, 14, m[schedule[14]], m[schedule[15]]);
+}
+
+// Transpose a 16x16 matrix of words, so that word j of vecs[i] ends up as
+// word i of vecs[j]. Each step interleaves pairs of vectors at twice the
+// width of the step before: 32-bit words, 64-bit pairs, then 128-bit
+// quarters twice over.
+INLINE void transpose(__m512i vecs[16]) {
+  __m512i a0 = _mm512_unpacklo_epi32(vecs[0], vecs[1]);
+  __m512i a1 = _mm512_unpackhi_epi32(vecs[0], vecs[1]);
+  __m512i a2 = _mm512_unpacklo_epi32(vecs[2], vecs[3]);
+  __m512i a3 = _mm512_unpackhi_epi32(vecs[2], vecs[3]);
+  __m512i a4 = _mm512_unpacklo_epi32(vecs[4], vecs[5]);
+  __m512i a5 = _mm512_unpackhi_epi32(vecs[4], vecs[5]);
+  __m512i a6 = _mm512_unpacklo_epi32(vecs[6], vecs[7]);
+  __m512i a7 = _mm512_unpackhi_epi32(vecs[6], vecs[7]);
+  __m512i a8 = _mm512_unpacklo_epi32(vecs[8], vecs[9]);
+  __m512i a9 = _mm512_unpackhi_epi32(vecs[8], vecs[9]);
+  __m512i a10 = _mm512_unpacklo_epi32(vecs[10], vecs[11]);
+  __m512i a11 = _mm512_unpackhi_epi32(vecs[10], vecs[11]);
+  __m512i a12 = _mm512_unpacklo_epi32(vecs[12], vecs[13]);
+  __m512i a13 = _mm512_unpackhi_epi32(vecs[12], vecs[13]);
+  __m512i a14 = _mm512_unpacklo_epi32(vecs[14], vecs[15]);
+  __m512i a15 = _mm512_unpackhi_epi32(vecs[14], vecs[15]);
+
+  __m512i b0 = _mm512_unpacklo_epi64(a0, a2);
+  __m512i b1 = _mm512_unpackhi_epi64(a0, a2);
+  __m512i b2 = _mm512_unpacklo_epi64(a1, a3);
+  __m512i b3 = _mm512_unpackhi_epi64(a1, a3);
+  __m512i b4 = _mm512_unpacklo_epi64(a4, a6);
+  __m512i b5 = _mm512_unpackhi_epi64(a4, a6);
+  __m512i b6 = _mm512_unpacklo_epi64(a5, a7);
+  __m512i b7 = _mm512_unpackhi_epi64(a5, a7);
+  __m512i b8 = _mm512_unpacklo_epi64(a8, a10);
+  __m512i b9 = _mm512_unpackhi_epi64(a8, a10);
+  __m512i b10 = _mm512_unpacklo_epi64(a9, a11);
+  __m512i b11 = _mm512_unpackhi_epi64(a9, a11);
+  __m512i b12 = _mm512_unpacklo_epi64(a12, a14);
+  __m512i b13 = _mm512_unpackhi_epi64(a12, a14);
+  __m512i b14 = _mm512_unpacklo_epi64(a13, a15);
+  __m512i b15 = _mm512_unpackhi_epi64(a13, a15);
+
+  // Quarter q of b[4 * k + j] now holds word 4 * q + j of rows 4 * k to
+  // 4 * k + 3. The last two steps move it to quarter k of vecs[4 * q + j].
+  __m512i c0 = _mm512_shuffle_i32x4(b0, b4, 0x88);
+  __m512i c4 = _mm512_shuffle_i32x4(b0, b4, 0xdd);
+  __m512i c8 = _mm512_shuffle_i32x4(b8, b12, 0x88);
+  __m512i c12 = _mm512_shuffle_i32x4(b8, b12, 0xdd);
+  __m512i c1 = _mm512_shuffle_i32x4(b1, b5, 0x88);
+  __m512i c5 = _mm512_shuffle_i32x4(b1, b5, 0xdd);
+  __m512i c9 = _mm512_shuffle_i32x4(b9, b13, 0x88);
+  __m512i c13 = _mm512_shuffle_i32x4(b9, b13, 0xdd);
+  __m512i c2 = _mm512_shuffle_i32x4(b2, b6, 0x88);
+  __m512i c6 = _mm512_shuffle_i32x4(b2, b6, 0xdd);
+  __m512i c10 = _mm512_shuffle_i32x4(b10, b14, 0x88);
+  __m512i c14 = _mm512_shuffle_i32x4(b10, b14, 0xdd);
+  __m512i c3 = _mm512_shuffle_i32x4(b3, b7, 0x88);
+  __m512i c7 = _mm512_shuffle_i32x4(b3, b7, 0xdd);
+  __m512i c11 = _mm512_shuffle_i32x4(b11, b15, 0x88);
+  __m512i c15 = _mm512_shuffle_i32x4(b11, b15, 0xdd);
+
+  vecs[0] = _mm512_shuffle_i32x4(c0, c8, 0x88);
+  vecs[8] = _mm512_shuffle_i32x4(c0, c8, 0xdd);
+  vecs[4] = _mm512_shuffle_i32x4(c4, c12, 0x88);
+  vecs[12] = _mm512_shuffle_i32x4(c4, c12, 0xdd);
+  vecs[1] = _mm512_shuffle_i32x4(c1, c9, 0x88);
+  vecs[9] = _mm512_shuffle_i32x4(c1, c9, 0xdd);
+  vecs[5] = _mm512_shuffle_i32x4(c5, c13, 0x88);
+  vecs[13] = _mm512_shuffle_i32x4(c5, c13, 0xdd);
+  vecs[2] = _mm512_shuffle_i32x4(c2, c10, 0x88);
+  vecs[10] = _mm512_shuffle_i32x4(c2, c10, 0xdd);
+  vecs[6] = _mm512_shuffle_i32x4(c6, c14, 0x88);
+  vecs[14] = _mm512_shuffle_i32x4(c6, c14, 0xdd);
+  vecs[3] = _mm512_shuffle_i32x4(c3, c11, 0x88);
+  vecs[11] = _mm512_shuffle_i32x4(c3, c11, 0xdd);
+  vecs[7] = _mm512_shuffle_i32x4(c7, c15, 0x88);
+  vecs[15] = _mm512_shuffle_i32x4(c7, c15, 0xdd);
+}
+
+void blake3_compress_lanes16_avx512(blake3_lane *lanes, size_t num_lanes) {
+  // Lanes past num_lanes, and lanes that have run out of blocks, read this
+  // instead of their input. Their results are discarded.
+  static const uint8_t zero_block[BLAKE3_BLOCK_LEN];
+  uint32_t cv_words[8][LANES] = {{0}};
+  uint32_t counter_lo_words[LANES] = {0};
+  uint32_t counter_hi_words[LANES] = {0};
+  uint32_t flags_words[LANES] = {0};
+  uint32_t flags_start_words[LANES] = {0};
+  uint32_t flags_end_words[LANES] = {0};
+  uint32_t blocks_words[LANES] = {0};
+  size_t max_blocks = 0;
+  for (size_t i = 0; i < num_lanes; i++) {
+    for (size_t j = 0; j < 8; j++) {
+      cv_words[j][i] = lanes[i].cv[j];
+    }
+    counter_lo_words[i] = counter_low(lanes[i].counter);
+    counter_hi_words[i] = counter_high(lanes[i].counter);
+    flags_words[i] = lanes[i].flags;
+    flags_start_words[i] = lanes[i].flags_start;
+    flags_end_words[i] = lanes[i].flags_end;
+    blocks_words[i] = (uint32_t)lanes[i].blocks;
+    if (lanes[i].blocks > max_blocks) {
+      max_blocks = lanes[i].blocks;
+    }
+  }
+
+  __m512i h[8];
+  for (size_t j = 0; j < 8; j++) {
+    h[j] = loadu_words(cv_words[j]);
+  }
+  const __m512i counter_lo = loadu_words(counter_lo_words);
+  const __m512i counter_hi = loadu_words(counter_hi_words);
+  const __m512i flags = loadu_words(flags_words);
+  const __m512i flags_start = loadu_words(flags_start_words);
+  const __m512i flags_end = loadu_words(flags_end_words);
+  const __m512i blocks = loadu_words(blocks_words);
+  const __m512i block_len = set1_512(BLAKE3_BLOCK_LEN);
+
+  for (size_t b = 0; b < max_blocks; b++) {
+    __m512i m[16];
+    for (size_t i = 0; i < LANES; i++) {
+      const uint8_t *block = zero_block;
+      if (i < num_lanes && b < lanes[i].blocks) {
+        block = &lanes[i].input[b * BLAKE3_BLOCK_LEN];
+      }
+      m[i] = _mm512_loadu_si512((const void *)block);
+    }
+    transpose(m);
+
+    const __mmask16 active =
+        _mm512_cmpgt_epu32_mask(blocks, set1_512((uint32_t)b));
+    const __mmask16 last =
+        _mm512_cmpeq_epi32_mask(blocks, set1_512((uint32_t)b + 1));
+    __m512i block_flags = flags;
+    if (b == 0) {
+      block_flags = _mm512_or_si512(block_flags, flags_start);
+    }
+    block_flags = _mm512_mask_or_epi32(block_flags, last, block_flags,
+                                       flags_end);
+
+    __m512i v[16] = {
+        h[0],            h[1],            h[2],            h[3],
+        h[4],            h[5],            h[6],            h[7],
+        set1_512(IV[0]), set1_512(IV[1]), set1_512(IV[2]), set1_512(IV[3]),
+        counter_lo,      counter_hi,      block_len,       block_flags,
+    };
+    round_fn(v, m, 0);
+    round_fn(v, m, 1);
+    round_fn(v, m, 2);
+    round_fn(v, m, 3);
+    round_fn(v, m, 4);
+    round_fn(v, m, 5);
+    round_fn(v, m, 6);
+    for (size_t j = 0; j < 8; j++) {
+      h[j] = _mm512_mask_xor_epi32(h[j], active, v[j], v[j + 8]);
+    }
+  }
+
+  for (size_t j = 0; j < 8; j++) {
+    _mm512_storeu_si512((void *)cv_words[j], h[j]);
+  }
+  for (size_t i = 0; i < num_lanes; i++) {
+    for (size_t j = 0; j < 8; j++) {
+      lanes[i].cv[j] = cv_words[j][i];
+    }
+  }
+}
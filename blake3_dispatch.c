@@ -1,9 +1,31 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "blake3_impl.h"
 
+// The x86 backends come either from the assembly files (WITH_ASM) or from the
+// intrinsics files (WITH_INTRINSICS). Both provide the same functions.
+#if defined(WITH_ASM) && defined(WITH_INTRINSICS)
+#error "WITH_ASM and WITH_INTRINSICS can't be used together"
+#endif
+#if (defined(WITH_ASM) || defined(WITH_INTRINSICS)) && defined(__x86_64__)
+#define WITH_X86
+#endif
+
+#if defined(WITH_X86) && !defined(WITH_ASM)
+#include <cpuid.h>
+#endif
+
+// The AVX-512 lane kernel, which needs a compiler with AVX-512 intrinsics even
+// in the assembly build. Without it, the AVX-512 backend has no
+// compress_lanes.
+#if defined(WITH_X86) && defined(WITH_AVX512_LANES)
+#define WITH_LANES
+#endif
+
 // Declarations for implementation-specific functions.
 void blake3_compress_in_place_portable(uint32_t cv[8],
                                        const uint8_t block[BLAKE3_BLOCK_LEN],
@@ -21,9 +43,21 @@ void blake3_hash_many_portable(const uint8_t *const *inputs, size_t num_inputs,
                                uint8_t flags, uint8_t flags_start,
                                uint8_t flags_end, uint8_t *out);
 
-#if defined(WITH_ASM) && defined(__x86_64__)
+#if defined(WITH_X86)
+#if defined(WITH_ASM)
 void blake3_cpuid(uint32_t out[4], uint32_t id, uint32_t sid);
 uint64_t blake3_xgetbv(void);
+#else
+static void blake3_cpuid(uint32_t out[4], uint32_t id, uint32_t sid) {
+  __cpuid_count(id, sid, out[0], out[1], out[2], out[3]);
+}
+
+static uint64_t blake3_xgetbv(void) {
+  uint32_t eax, edx;
+  __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  return (uint64_t)edx << 32 | eax;
+}
+#endif
 
 void blake3_compress_in_place_sse2(uint32_t cv[8],
                                    const uint8_t block[BLAKE3_BLOCK_LEN],
@@ -52,12 +86,20 @@ void blake3_hash_many_sse41(const uint8_t *const *inputs, size_t num_inputs,
                             uint64_t counter, bool increment_counter,
                             uint8_t flags, uint8_t flags_start,
                             uint8_t flags_end, uint8_t *out);
+void blake3_xof4_sse41(const uint32_t cv[8],
+                       const uint8_t block[BLAKE3_BLOCK_LEN],
+                       uint8_t block_len, uint64_t counter, uint8_t flags,
+                       uint8_t out[4 * 64]);
 
 void blake3_hash_many_avx2(const uint8_t *const *inputs, size_t num_inputs,
                            size_t blocks, const uint32_t key[8],
                            uint64_t counter, bool increment_counter,
                            uint8_t flags, uint8_t flags_start,
                            uint8_t flags_end, uint8_t *out);
+void blake3_xof8_avx2(const uint32_t cv[8],
+                      const uint8_t block[BLAKE3_BLOCK_LEN],
+                      uint8_t block_len, uint64_t counter, uint8_t flags,
+                      uint8_t out[8 * 64]);
 
 void blake3_compress_in_place_avx512(uint32_t cv[8],
                                      const uint8_t block[BLAKE3_BLOCK_LEN],
@@ -72,6 +114,15 @@ void blake3_hash_many_avx512(const uint8_t *const *inputs, size_t num_inputs,
                              uint64_t counter, bool increment_counter,
                              uint8_t flags, uint8_t flags_start,
                              uint8_t flags_end, uint8_t *out);
+void blake3_xof16_avx512(const uint32_t cv[8],
+                         const uint8_t block[BLAKE3_BLOCK_LEN],
+                         uint8_t block_len, uint64_t counter, uint8_t flags,
+                         uint8_t out[16 * 64]);
+#if defined(WITH_LANES)
+void blake3_compress_lanes16_avx512(blake3_lane *lanes, size_t num_lanes);
+#endif
+
+#endif
 
 enum {
   SSE2   = 1 << 0,
@@ -80,8 +131,183 @@ enum {
   AVX512 = 1 << 3,
 };
 
-int blake3_cpu_features;
+// Each xof_many loop uses the widest XOF kernel first and steps down through
+// narrower ones, finishing any remainder one block at a time.
+static void blake3_xof_many_portable(const uint32_t cv[8],
+                                     const uint8_t block[BLAKE3_BLOCK_LEN],
+                                     uint8_t block_len, uint64_t counter,
+                                     uint8_t flags, uint8_t *out,
+                                     size_t outblocks) {
+  for (; outblocks > 0; outblocks--) {
+    blake3_compress_xof_portable(cv, block, block_len, counter, flags, out);
+    counter += 1;
+    out += 64;
+  }
+}
+
+#if defined(WITH_X86)
+static void blake3_xof_many_sse2(const uint32_t cv[8],
+                                 const uint8_t block[BLAKE3_BLOCK_LEN],
+                                 uint8_t block_len, uint64_t counter,
+                                 uint8_t flags, uint8_t *out,
+                                 size_t outblocks) {
+  for (; outblocks > 0; outblocks--) {
+    blake3_compress_xof_sse2(cv, block, block_len, counter, flags, out);
+    counter += 1;
+    out += 64;
+  }
+}
+
+static void blake3_xof_many_sse41(const uint32_t cv[8],
+                                  const uint8_t block[BLAKE3_BLOCK_LEN],
+                                  uint8_t block_len, uint64_t counter,
+                                  uint8_t flags, uint8_t *out,
+                                  size_t outblocks) {
+  for (; outblocks >= 4; outblocks -= 4) {
+    blake3_xof4_sse41(cv, block, block_len, counter, flags, out);
+    counter += 4;
+    out += 4 * 64;
+  }
+  for (; outblocks > 0; outblocks--) {
+    blake3_compress_xof_sse41(cv, block, block_len, counter, flags, out);
+    counter += 1;
+    out += 64;
+  }
+}
+
+static void blake3_xof_many_avx2(const uint32_t cv[8],
+                                 const uint8_t block[BLAKE3_BLOCK_LEN],
+                                 uint8_t block_len, uint64_t counter,
+                                 uint8_t flags, uint8_t *out,
+                                 size_t outblocks) {
+  for (; outblocks >= 8; outblocks -= 8) {
+    blake3_xof8_avx2(cv, block, block_len, counter, flags, out);
+    counter += 8;
+    out += 8 * 64;
+  }
+  blake3_xof_many_sse41(cv, block, block_len, counter, flags, out, outblocks);
+}
+
+static void blake3_xof_many_avx512(const uint32_t cv[8],
+                                   const uint8_t block[BLAKE3_BLOCK_LEN],
+                                   uint8_t block_len, uint64_t counter,
+                                   uint8_t flags, uint8_t *out,
+                                   size_t outblocks) {
+  for (; outblocks >= 16; outblocks -= 16) {
+    blake3_xof16_avx512(cv, block, block_len, counter, flags, out);
+    counter += 16;
+    out += 16 * 64;
+  }
+  for (; outblocks >= 8; outblocks -= 8) {
+    blake3_xof8_avx2(cv, block, block_len, counter, flags, out);
+    counter += 8;
+    out += 8 * 64;
+  }
+  for (; outblocks >= 4; outblocks -= 4) {
+    blake3_xof4_sse41(cv, block, block_len, counter, flags, out);
+    counter += 4;
+    out += 4 * 64;
+  }
+  for (; outblocks > 0; outblocks--) {
+    blake3_compress_xof_avx512(cv, block, block_len, counter, flags, out);
+    counter += 1;
+    out += 64;
+  }
+}
+#endif
+
+#if defined(WITH_LANES)
+// The lanes too few to be worth a kernel call go through one block at a time.
+INLINE void compress_lanes_serial(blake3_compress_in_place_fn compress,
+                                  blake3_lane *lanes, size_t num_lanes) {
+  for (size_t i = 0; i < num_lanes; i++) {
+    blake3_lane *lane = &lanes[i];
+    for (size_t b = 0; b < lane->blocks; b++) {
+      uint8_t flags = lane->flags;
+      if (b == 0) {
+        flags |= lane->flags_start;
+      }
+      if (b + 1 == lane->blocks) {
+        flags |= lane->flags_end;
+      }
+      compress(lane->cv, &lane->input[b * BLAKE3_BLOCK_LEN], BLAKE3_BLOCK_LEN,
+               lane->counter, flags);
+    }
+  }
+}
+
+// A group of 16 lanes costs the same however many of them are in use, so
+// only a group with at least this many lanes goes through the kernel.
+#define AVX512_MIN_LANES 3
+
+static void blake3_compress_lanes_avx512(blake3_lane *lanes,
+                                         size_t num_lanes) {
+  while (num_lanes >= AVX512_MIN_LANES) {
+    size_t n = num_lanes < 16 ? num_lanes : 16;
+    blake3_compress_lanes16_avx512(lanes, n);
+    lanes += n;
+    num_lanes -= n;
+  }
+  compress_lanes_serial(blake3_compress_in_place_avx512, lanes, num_lanes);
+}
+#define AVX512_LANES blake3_compress_lanes_avx512
+#else
+#define AVX512_LANES NULL
+#endif
+
+// Backends from most to least preferred, with the features each one needs.
+// The AVX2 backend has no single-block compression of its own and uses
+// SSE4.1 for that.
+static const blake3_backend backends[] = {
+#if defined(WITH_X86)
+    {"avx512", SSE2 | SSE41 | AVX2 | AVX512, blake3_compress_in_place_avx512,
+     blake3_compress_xof_avx512, blake3_hash_many_avx512,
+     blake3_xof_many_avx512, AVX512_LANES, 16},
+    {"avx2", SSE2 | SSE41 | AVX2, blake3_compress_in_place_sse41,
+     blake3_compress_xof_sse41, blake3_hash_many_avx2, blake3_xof_many_avx2,
+     NULL, 8},
+    {"sse41", SSE2 | SSE41, blake3_compress_in_place_sse41,
+     blake3_compress_xof_sse41, blake3_hash_many_sse41,
+     blake3_xof_many_sse41, NULL, 4},
+    {"sse2", SSE2, blake3_compress_in_place_sse2, blake3_compress_xof_sse2,
+     blake3_hash_many_sse2, blake3_xof_many_sse2, NULL, 4},
+#endif
+    {"portable", 0, blake3_compress_in_place_portable,
+     blake3_compress_xof_portable, blake3_hash_many_portable,
+     blake3_xof_many_portable, NULL, 1},
+};
+
+#define NUM_BACKENDS (sizeof(backends) / sizeof(backends[0]))
+
+// The backend in use, only ever stored and loaded atomically. It starts out
+// portable, so hashing works even before blake3_detect_cpu_features() runs.
+const blake3_backend *blake3_active_backend = &backends[NUM_BACKENDS - 1];
 
+// The features the CPU actually has, and the backend selected at startup.
+static int blake3_detected_features;
+static size_t blake3_default_backend = NUM_BACKENDS - 1;
+
+// Returns the index of the named backend, or NUM_BACKENDS if it's unknown or
+// unsupported.
+static size_t find_backend(const char *name) {
+  for (size_t i = 0; i < NUM_BACKENDS; i++) {
+    if (strcmp(name, backends[i].name) == 0) {
+      if ((blake3_detected_features & backends[i].features) !=
+          backends[i].features) {
+        break;
+      }
+      return i;
+    }
+  }
+  return NUM_BACKENDS;
+}
+
+#if defined(WITH_X86)
+
+// blake3_cpuid.S adds this to .init_array for the assembly build.
+#if defined(WITH_INTRINSICS)
+__attribute__((constructor))
+#endif
 void blake3_detect_cpu_features(void) {
 #if defined(__x86_64__)
   enum { EAX, EBX, ECX, EDX };
@@ -107,100 +333,33 @@ void blake3_detect_cpu_features(void) {
         features |= AVX512;
     }
   }
-  blake3_cpu_features = features;
-#endif
-}
-#endif
-
-void blake3_compress_in_place(uint32_t cv[8],
-                              const uint8_t block[BLAKE3_BLOCK_LEN],
-                              uint8_t block_len, uint64_t counter,
-                              uint8_t flags) {
-#if defined(WITH_ASM) && defined(__x86_64__)
-  if (blake3_cpu_features & AVX512) {
-    blake3_compress_in_place_avx512(cv, block, block_len, counter, flags);
-    return;
-  }
-  if (blake3_cpu_features & SSE41) {
-    blake3_compress_in_place_sse41(cv, block, block_len, counter, flags);
-    return;
-  }
-  if (blake3_cpu_features & SSE2) {
-    blake3_compress_in_place_sse2(cv, block, block_len, counter, flags);
-    return;
-  }
-#endif
-  blake3_compress_in_place_portable(cv, block, block_len, counter, flags);
-}
+  blake3_detected_features = features;
 
-void blake3_compress_xof(const uint32_t cv[8],
-                         const uint8_t block[BLAKE3_BLOCK_LEN],
-                         uint8_t block_len, uint64_t counter, uint8_t flags,
-                         uint8_t out[64]) {
-#if defined(WITH_ASM) && defined(__x86_64__)
-  if (blake3_cpu_features & AVX512) {
-    blake3_compress_xof_avx512(cv, block, block_len, counter, flags, out);
-    return;
-  }
-  if (blake3_cpu_features & SSE41) {
-    blake3_compress_xof_sse41(cv, block, block_len, counter, flags, out);
-    return;
+  // The portable backend needs no features, so this always finds one.
+  size_t i = 0;
+  while ((features & backends[i].features) != backends[i].features) {
+    i++;
   }
-  if (blake3_cpu_features & SSE2) {
-    blake3_compress_xof_sse2(cv, block, block_len, counter, flags, out);
-    return;
+  const char *name = getenv("BLAKE3_BACKEND");
+  if (name != NULL && find_backend(name) < NUM_BACKENDS) {
+    i = find_backend(name);
   }
+  blake3_default_backend = i;
+  __atomic_store_n(&blake3_active_backend, &backends[i], __ATOMIC_RELEASE);
 #endif
-  blake3_compress_xof_portable(cv, block, block_len, counter, flags, out);
 }
-
-void blake3_hash_many(const uint8_t *const *inputs, size_t num_inputs,
-                      size_t blocks, const uint32_t key[8], uint64_t counter,
-                      bool increment_counter, uint8_t flags,
-                      uint8_t flags_start, uint8_t flags_end, uint8_t *out) {
-#if defined(WITH_ASM) && defined(__x86_64__)
-  if (blake3_cpu_features & AVX512) {
-    blake3_hash_many_avx512(inputs, num_inputs, blocks, key, counter,
-                            increment_counter, flags, flags_start, flags_end,
-                            out);
-    return;
-  }
-  if (blake3_cpu_features & AVX2) {
-    blake3_hash_many_avx2(inputs, num_inputs, blocks, key, counter,
-                          increment_counter, flags, flags_start, flags_end,
-                          out);
-    return;
-  }
-  if (blake3_cpu_features & SSE41) {
-    blake3_hash_many_sse41(inputs, num_inputs, blocks, key, counter,
-                           increment_counter, flags, flags_start, flags_end,
-                           out);
-    return;
-  }
-  if (blake3_cpu_features & SSE2) {
-    blake3_hash_many_sse2(inputs, num_inputs, blocks, key, counter,
-                          increment_counter, flags, flags_start, flags_end,
-                          out);
-    return;
-  }
 #endif
 
-  blake3_hash_many_portable(inputs, num_inputs, blocks, key, counter,
-                            increment_counter, flags, flags_start, flags_end,
-                            out);
-}
+const char *blake3_get_backend(void) { return blake3_backend_active()->name; }
 
-// The dynamically detected SIMD degree of the current platform.
-size_t blake3_simd_degree(void) {
-#if defined(WITH_ASM) && defined(__x86_64__)
-  if (blake3_cpu_features & AVX512)
-    return 16;
-  if (blake3_cpu_features & AVX2)
-    return 8;
-  if (blake3_cpu_features & SSE41)
-    return 4;
-  if (blake3_cpu_features & SSE2)
-    return 4;
-#endif
-  return 1;
+int blake3_set_backend(const char *name) {
+  size_t i = blake3_default_backend;
+  if (name != NULL) {
+    i = find_backend(name);
+    if (i == NUM_BACKENDS) {
+      return -1;
+    }
+  }
+  __atomic_store_n(&blake3_active_backend, &backends[i], __ATOMIC_RELEASE);
+  return 0;
 }
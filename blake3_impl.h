@@ -4,6 +4,7 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "blake3.h"
 
@@ -19,6 +20,22 @@ static const uint32_t IV[8] = {0x6A09E667UL, 0xBB67AE85UL, 0x3C6EF372UL,
                                0xA54FF53AUL, 0x510E527FUL, 0x9B05688CUL,
                                0x1F83D9ABUL, 0x5BE0CD19UL};
 
+static const uint8_t MSG_SCHEDULE[7][16] = {
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+    {2, 6, 3, 10, 7, 0, 4, 13, 1, 11, 12, 5, 9, 14, 15, 8},
+    {3, 4, 10, 12, 13, 2, 7, 14, 6, 5, 9, 0, 11, 15, 8, 1},
+    {10, 7, 12, 9, 14, 3, 13, 15, 4, 0, 11, 2, 5, 8, 1, 6},
+    {12, 13, 9, 11, 15, 10, 14, 8, 7, 2, 5, 3, 0, 1, 6, 4},
+    {9, 14, 11, 5, 8, 12, 15, 1, 13, 3, 0, 10, 2, 6, 4, 7},
+    {11, 15, 5, 0, 1, 9, 8, 6, 14, 10, 2, 12, 3, 4, 7, 13},
+};
+
+INLINE uint32_t counter_low(uint64_t counter) { return (uint32_t)counter; }
+
+INLINE uint32_t counter_high(uint64_t counter) {
+  return (uint32_t)(counter >> 32);
+}
+
 INLINE uint32_t load32(const void *src) {
   const uint8_t *p = (const uint8_t *)src;
   return ((uint32_t)(p[0]) << 0) | ((uint32_t)(p[1]) << 8) |
@@ -44,21 +61,107 @@ INLINE void store_cv_words(uint8_t bytes_out[32], uint32_t cv_words[8]) {
   store32(&bytes_out[7 * 4], cv_words[7]);
 }
 
-void blake3_compress_in_place(uint32_t cv[8],
-                              const uint8_t block[BLAKE3_BLOCK_LEN],
-                              uint8_t block_len, uint64_t counter,
-                              uint8_t flags);
+typedef void (*blake3_compress_in_place_fn)(
+    uint32_t cv[8], const uint8_t block[BLAKE3_BLOCK_LEN], uint8_t block_len,
+    uint64_t counter, uint8_t flags);
+typedef void (*blake3_compress_xof_fn)(const uint32_t cv[8],
+                                       const uint8_t block[BLAKE3_BLOCK_LEN],
+                                       uint8_t block_len, uint64_t counter,
+                                       uint8_t flags, uint8_t out[64]);
+typedef void (*blake3_hash_many_fn)(const uint8_t *const *inputs,
+                                    size_t num_inputs, size_t blocks,
+                                    const uint32_t key[8], uint64_t counter,
+                                    bool increment_counter, uint8_t flags,
+                                    uint8_t flags_start, uint8_t flags_end,
+                                    uint8_t *out);
+typedef void (*blake3_xof_many_fn)(const uint32_t cv[8],
+                                   const uint8_t block[BLAKE3_BLOCK_LEN],
+                                   uint8_t block_len, uint64_t counter,
+                                   uint8_t flags, uint8_t *out,
+                                   size_t outblocks);
+
+// One lane of compress_lanes: a chaining value, and whole blocks of a single
+// chunk to compress into it. Unlike the inputs of hash_many, each lane has
+// its own counter and flags. The first block also gets flags_start, and the
+// last one flags_end.
+typedef struct {
+  uint32_t cv[8];
+  const uint8_t *input;
+  size_t blocks;
+  uint64_t counter;
+  uint8_t flags;
+  uint8_t flags_start;
+  uint8_t flags_end;
+} blake3_lane;
+
+typedef void (*blake3_compress_lanes_fn)(blake3_lane *lanes, size_t num_lanes);
+
+// One implementation of the compression primitives. The dispatch functions
+// below call through the active backend, which blake3_dispatch.c selects once
+// at startup and again on each blake3_set_backend(). Backends are constant
+// table entries, published through a single pointer, so a caller that loads
+// it once sees every field of the same backend.
+typedef struct {
+  const char *name;
+  int features;
+  blake3_compress_in_place_fn compress_in_place;
+  blake3_compress_xof_fn compress_xof;
+  blake3_hash_many_fn hash_many;
+  // Compute outblocks consecutive 64-byte blocks of extended output,
+  // starting at the given counter.
+  blake3_xof_many_fn xof_many;
+  // Compress any number of lanes, several at a time. NULL for backends
+  // without a lane kernel.
+  blake3_compress_lanes_fn compress_lanes;
+  size_t simd_degree;
+} blake3_backend;
+
+BLAKE3_PRIVATE extern const blake3_backend *blake3_active_backend;
+
+// The active backend. Another thread may switch it at any time, so callers
+// that need two of its fields to agree should load it once.
+INLINE const blake3_backend *blake3_backend_active(void) {
+  return __atomic_load_n(&blake3_active_backend, __ATOMIC_ACQUIRE);
+}
+
+INLINE void blake3_compress_in_place(uint32_t cv[8],
+                                     const uint8_t block[BLAKE3_BLOCK_LEN],
+                                     uint8_t block_len, uint64_t counter,
+                                     uint8_t flags) {
+  blake3_backend_active()->compress_in_place(cv, block, block_len, counter,
+                                          flags);
+}
 
-void blake3_compress_xof(const uint32_t cv[8],
-                         const uint8_t block[BLAKE3_BLOCK_LEN],
-                         uint8_t block_len, uint64_t counter, uint8_t flags,
-                         uint8_t out[64]);
+INLINE void blake3_compress_xof(const uint32_t cv[8],
+                                const uint8_t block[BLAKE3_BLOCK_LEN],
+                                uint8_t block_len, uint64_t counter,
+                                uint8_t flags, uint8_t out[64]) {
+  blake3_backend_active()->compress_xof(cv, block, block_len, counter, flags,
+                                     out);
+}
 
-void blake3_hash_many(const uint8_t *const *inputs, size_t num_inputs,
-                      size_t blocks, const uint32_t key[8], uint64_t counter,
-                      bool increment_counter, uint8_t flags,
-                      uint8_t flags_start, uint8_t flags_end, uint8_t *out);
+INLINE void blake3_hash_many(const uint8_t *const *inputs, size_t num_inputs,
+                             size_t blocks, const uint32_t key[8],
+                             uint64_t counter, bool increment_counter,
+                             uint8_t flags, uint8_t flags_start,
+                             uint8_t flags_end, uint8_t *out) {
+  blake3_backend_active()->hash_many(inputs, num_inputs, blocks, key, counter,
+                                  increment_counter, flags, flags_start,
+                                  flags_end, out);
+}
 
-size_t blake3_simd_degree(void);
+INLINE void blake3_xof_many(const uint32_t cv[8],
+                            const uint8_t block[BLAKE3_BLOCK_LEN],
+                            uint8_t block_len, uint64_t counter, uint8_t flags,
+                            uint8_t *out, size_t outblocks) {
+  blake3_backend_active()->xof_many(cv, block, block_len, counter, flags, out,
+                                 outblocks);
+}
+
+
+// The SIMD degree of the active backend.
+INLINE size_t blake3_simd_degree(void) {
+  return blake3_backend_active()->simd_degree;
+}
 
 #endif /* BLAKE3_IMPL_H */
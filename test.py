@@ -2,22 +2,132 @@
 
 from binascii import hexlify
 import json
+import os
+import resource
 from os import path
 import subprocess
+import struct
+import tempfile
+import time
 
 HERE = path.dirname(__file__)
 TEST_VECTORS_PATH = path.join(HERE, "test_vectors.json")
 TEST_VECTORS = json.load(open(TEST_VECTORS_PATH))
 
 
-def run_blake3(args, input):
+BACKENDS = ["portable", "sse2", "sse41", "avx2", "avx512"]
+
+# XOF lengths that reach each wide kernel: 16, 8 and 4 blocks at a time, and
+# every step down to a single partial block.
+XOF_LENS = [1024, 29 * 64 + 1, 4096, 4097]
+
+
+def run_blake3(args, input, env=None):
     output = subprocess.run([path.join(HERE, "b3sum")] + args,
                             input=input,
                             stdout=subprocess.PIPE,
+                            env=env,
                             check=True)
     return output.stdout.partition(b' ')[0].decode().strip()
 
 
+def run_b3sum(args, input=None, cwd=None):
+    output = subprocess.run([path.abspath(path.join(HERE, "b3sum"))] + args,
+                            input=input,
+                            stdout=subprocess.PIPE,
+                            stderr=subprocess.PIPE,
+                            cwd=cwd)
+    return output.returncode, output.stdout, output.stderr
+
+
+# A slow but straightforward BLAKE3, in the default hash mode only, to check
+# output lengths that the test vectors don't cover.
+IV = [
+    0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A, 0x510E527F, 0x9B05688C,
+    0x1F83D9AB, 0x5BE0CD19
+]
+MSG_PERMUTATION = [2, 6, 3, 10, 7, 0, 4, 13, 1, 11, 12, 5, 9, 14, 15, 8]
+CHUNK_START, CHUNK_END, PARENT, ROOT = 1, 2, 4, 8
+
+
+def rotr(x, n):
+    return ((x >> n) | (x << (32 - n))) & 0xffffffff
+
+
+def g(v, a, b, c, d, mx, my):
+    v[a] = (v[a] + v[b] + mx) & 0xffffffff
+    v[d] = rotr(v[d] ^ v[a], 16)
+    v[c] = (v[c] + v[d]) & 0xffffffff
+    v[b] = rotr(v[b] ^ v[c], 12)
+    v[a] = (v[a] + v[b] + my) & 0xffffffff
+    v[d] = rotr(v[d] ^ v[a], 8)
+    v[c] = (v[c] + v[d]) & 0xffffffff
+    v[b] = rotr(v[b] ^ v[c], 7)
+
+
+def compress(cv, block, counter, block_len, flags):
+    m = list(struct.unpack("<16I", block.ljust(64, b"\0")))
+    v = cv[:] + IV[:4] + [
+        counter & 0xffffffff, counter >> 32, block_len, flags
+    ]
+    for r in range(7):
+        g(v, 0, 4, 8, 12, m[0], m[1])
+        g(v, 1, 5, 9, 13, m[2], m[3])
+        g(v, 2, 6, 10, 14, m[4], m[5])
+        g(v, 3, 7, 11, 15, m[6], m[7])
+        g(v, 0, 5, 10, 15, m[8], m[9])
+        g(v, 1, 6, 11, 12, m[10], m[11])
+        g(v, 2, 7, 8, 13, m[12], m[13])
+        g(v, 3, 4, 9, 14, m[14], m[15])
+        m = [m[i] for i in MSG_PERMUTATION]
+    return [v[i] ^ v[i + 8] for i in range(8)] + \
+        [v[i + 8] ^ cv[i] for i in range(8)]
+
+
+# The root compression's inputs for a chunk, or the chaining value of a
+# non-root chunk.
+def chunk_output(chunk, counter):
+    cv = IV[:]
+    blocks = [chunk[i:i + 64] for i in range(0, len(chunk), 64)] or [b""]
+    for i, block in enumerate(blocks):
+        flags = CHUNK_START if i == 0 else 0
+        if i == len(blocks) - 1:
+            return cv, block, counter, flags | CHUNK_END
+        cv = compress(cv, block, counter, 64, flags)[:8]
+
+
+def parent_output(left, right):
+    return IV, struct.pack("<16I", *(left + right)), 0, PARENT
+
+
+def output_cv(output):
+    cv, block, counter, flags = output
+    return compress(cv, block, counter, len(block), flags)[:8]
+
+
+def subtree_output(input, counter):
+    if len(input) <= 1024:
+        return chunk_output(input, counter)
+    # The left subtree is the largest power of 2 chunks that leaves at least
+    # one byte on the right.
+    left_len = 1024
+    while 2 * left_len < len(input):
+        left_len *= 2
+    left = output_cv(subtree_output(input[:left_len], counter))
+    right = output_cv(
+        subtree_output(input[left_len:], counter + left_len // 1024))
+    return parent_output(left, right)
+
+
+def reference_hash(input, out_len):
+    cv, block, _, flags = subtree_output(input, 0)
+    out = b""
+    while len(out) < out_len:
+        words = compress(cv, block, len(out) // 64, len(block), flags | ROOT)
+        out += struct.pack("<16I", *words)
+    return out[:out_len]
+
+
 # Fill the input with a repeating byte pattern. We use a cycle length of 251,
 # because that's the largest prime number less than 256. This makes it unlikely
 # to swapping any two adjacent input blocks or chunks will give the same
@@ -31,6 +141,322 @@ def make_test_input(length):
     return buf
 
 
+# Files of assorted sizes, some below the size at which b3sum maps them,
+# and the names and expected hashes of each.
+def make_files(dir, count):
+    files = []
+    for i in range(count):
+        name = "file{:02}".format(i)
+        input = make_test_input(i * i * 97 % 70000)
+        with open(path.join(dir, name), "wb") as f:
+            f.write(input)
+        files.append((name, reference_hash(input, 32).hex()))
+    return files
+
+
+# Output with several jobs at once must be byte for byte the same as with
+# one, including errors, which are reported in argument order.
+def test_jobs():
+    with tempfile.TemporaryDirectory() as dir:
+        files = make_files(dir, 40)
+        os.mkdir(path.join(dir, "subdir"))
+        args = []
+        for i, (name, _) in enumerate(files):
+            args.append(name)
+            if i % 7 == 3:
+                args.append("missing{}".format(i))
+            if i % 11 == 5:
+                args.append("subdir")
+        serial = run_b3sum(["-j", "1"] + args, cwd=dir)
+        assert serial[0] == 1, "b3sum -j 1 with errors exited {}".format(
+            serial[0])
+        lines = serial[1].decode().splitlines()
+        assert lines == ["{}  {}".format(h, n) for n, h in files], \
+            "b3sum -j 1: {}".format(lines)
+        errors = serial[2].decode().splitlines()
+        assert len(errors) == 10 and "missing3" in errors[0], \
+            "b3sum -j 1 errors: {}".format(errors)
+        for jobs in ["2", "4", "16"]:
+            parallel = run_b3sum(["-j", jobs] + args, cwd=dir)
+            assert parallel == serial, "b3sum -j {} != -j 1".format(jobs)
+
+        input = make_test_input(100000)
+        expected = run_b3sum([], input)
+        for jobs in ["1", "4"]:
+            assert run_b3sum(["-j", jobs], input) == expected, \
+                "b3sum -j {} stdin".format(jobs)
+        assert expected[1].decode() == "{}  <stdin>\n".format(
+            reference_hash(input, 32).hex())
+
+
+# Check a list with good and bad entries and lines that can't be checked.
+# Every message must come out in line order, whatever the number of jobs.
+def test_check():
+    with tempfile.TemporaryDirectory() as dir:
+        files = make_files(dir, 20)
+        lines = []
+        sums = []
+        stdout = []
+        stderr = []
+        for i, (name, hash) in enumerate(files):
+            if i % 5 == 1:
+                hash = hash[:-1] + ("0" if hash[-1] != "0" else "1")
+                stdout.append(name + ": FAILED")
+            elif i % 5 == 2:
+                # A shorter sum, as printed by -l
+                hash = hash[:32]
+                stdout.append(name + ": OK")
+            else:
+                stdout.append(name + ": OK")
+            sums.append("{} {}{}".format(hash, "*" if i % 3 else " ", name))
+            lines.append(sums[-1])
+            if i == 3:
+                lines.append("missing")
+                stderr.append("skipping invalid checksum line")
+            elif i == 6:
+                lines.append("abc  " + name)
+                stderr.append("skipping invalid checksum line")
+            elif i == 9:
+                lines.append("zz" * 32 + "  " + name)
+                stderr.append("skipping invalid checksum line")
+            elif i == 12:
+                lines.append("00" * 32 + "  nosuchfile")
+                stderr.append("open nosuchfile: No such file or directory")
+            elif i == 15:
+                lines.append("0" * 20000)
+                stderr.append("skipping line that is too long")
+            elif i == 17:
+                # Exactly fills the line buffer, newline included.
+                lines.append("0" * 8186 + "  ab")
+                stderr.append("open ab: No such file or directory")
+        checklist = "".join(line + "\n" for line in lines).encode()
+        with open(path.join(dir, "list"), "wb") as f:
+            f.write(checklist)
+
+        serial = run_b3sum(["-c", "list"], cwd=dir)
+        assert serial[0] == 1, "b3sum -c exited {}".format(serial[0])
+        assert serial[1].decode().splitlines() == stdout, \
+            "b3sum -c: {}".format(serial[1])
+        errors = [e.partition(": ")[2] for e in serial[2].decode().splitlines()]
+        assert errors == stderr, "b3sum -c errors: {}".format(errors)
+        for args in [["-j", "4", "-c", "list"], ["-j", "16", "-c", "list"]]:
+            assert run_b3sum(args, cwd=dir) == serial, \
+                "b3sum {} != -c".format(" ".join(args))
+        for jobs in ["1", "4"]:
+            assert run_b3sum(["-j", jobs, "-c"], checklist, dir) == serial, \
+                "b3sum -j {} -c from stdin".format(jobs)
+
+        good = "".join(line + "\n" for line, out in zip(sums, stdout)
+                       if out.endswith(": OK")).encode()
+        assert run_b3sum(["-j", "4", "-c"], good, dir)[0] == 0, \
+            "b3sum -c with good sums"
+
+
+def read_cache(name):
+    with open(name, "rb") as f:
+        data = f.read()
+    assert data[:8] == b"b3cache1", "bad cache header"
+    return [data[i:i + 72] for i in range(8, len(data), 72)]
+
+
+# Hits are shown by forging the sums in the cache, which b3sum then prints
+# without reading the files.
+def test_cache():
+    with tempfile.TemporaryDirectory() as dir:
+        files = make_files(dir, 10)
+        names = [name for name, _ in files]
+        cache = path.join(dir, "cache")
+        # Files written within the timestamp granularity aren't cached.
+        time.sleep(0.3)
+        out = run_b3sum(["-C", cache] + names, cwd=dir)
+        assert out[1].decode().splitlines() == [
+            "{}  {}".format(h, n) for n, h in files
+        ], "b3sum -C miss: {}".format(out)
+        entries = read_cache(cache)
+        assert len(entries) == len(files), "cache has {} entries".format(
+            len(entries))
+
+        forged = [e[:40] + bytes([i]) * 32 for i, e in enumerate(entries)]
+        with open(cache, "wb") as f:
+            f.write(b"b3cache1" + b"".join(forged))
+        os.chmod(cache, 0o640)
+        ino = {os.stat(path.join(dir, n)).st_ino: n for n in names}
+        sums = {
+            ino[struct.unpack("<Q", e[8:16])[0]]: e[40:].hex()
+            for e in forged
+        }
+        for jobs in ["1", "4"]:
+            out = run_b3sum(["-j", jobs, "-C", cache] + names, cwd=dir)
+            assert out[1].decode().splitlines() == [
+                "{}  {}".format(sums[n], n) for n in names
+            ], "b3sum -C hit: {}".format(out)
+
+        # A changed file misses, and its entry is replaced. A deleted
+        # one's entry is kept, since it isn't known to be gone.
+        with open(path.join(dir, names[0]), "ab") as f:
+            f.write(b"x")
+        os.unlink(path.join(dir, names[1]))
+        time.sleep(0.3)
+        out = run_b3sum(["-C", cache] + names, cwd=dir)
+        lines = out[1].decode().splitlines()
+        with open(path.join(dir, names[0]), "rb") as f:
+            input = f.read()
+        assert lines[0] == "{}  {}".format(reference_hash(input, 32).hex(),
+                                           names[0]), lines[0]
+        assert lines[1:] == [
+            "{}  {}".format(sums[n], n) for n in names[2:]
+        ], "b3sum -C after changes: {}".format(out)
+        assert len(read_cache(cache)) == len(files)
+        assert os.stat(cache).st_mode & 0o777 == 0o640, "cache mode changed"
+
+        # A file written just now is hashed but not added.
+        with open(path.join(dir, "fresh"), "wb") as f:
+            f.write(b"fresh")
+        out = run_b3sum(["-C", cache, "fresh"] + names[2:], cwd=dir)
+        assert out[1].decode().splitlines()[0] == "{}  fresh".format(
+            reference_hash(b"fresh", 32).hex()), out
+        fresh = os.stat(path.join(dir, "fresh")).st_ino
+        entries = read_cache(cache)
+        assert len(entries) == len(files) and all(
+            struct.unpack("<Q", e[8:16])[0] != fresh
+            for e in entries), "b3sum -C cached a racy file"
+
+        # -p drops the entries of files that weren't looked up.
+        out = run_b3sum(["-p", "-C", cache] + names[3:], cwd=dir)
+        assert out[0] == 0, out
+        entries = read_cache(cache)
+        assert sorted(struct.unpack("<Q", e[8:16])[0]
+                      for e in entries) == sorted(
+                          os.stat(path.join(dir, n)).st_ino
+                          for n in names[3:]), "b3sum -p -C kept entries"
+
+    # Two runs over disjoint files share the cache.
+    with tempfile.TemporaryDirectory() as dir:
+        files = make_files(dir, 8)
+        names = [name for name, _ in files]
+        cache = path.join(dir, "cache")
+        time.sleep(0.3)
+        for part in [names[:4], names[4:]]:
+            out = run_b3sum(["-j", "4", "-C", cache] + part, cwd=dir)
+            assert out[0] == 0, out
+        entries = read_cache(cache)
+        assert sorted(struct.unpack("<Q", e[8:16])[0]
+                      for e in entries) == sorted(
+                          os.stat(path.join(dir, n)).st_ino
+                          for n in names), "b3sum -C dropped other entries"
+
+
+# The regular files below a directory, depth first in name order, with
+# their expected output lines.
+def expected_walk(dir, root):
+    lines = []
+    for name in sorted(os.listdir(path.join(dir, root))):
+        sub = root.rstrip("/") + "/" + name
+        full = path.join(dir, sub)
+        if path.islink(full):
+            continue
+        if path.isdir(full):
+            lines += expected_walk(dir, sub)
+        elif path.isfile(full):
+            with open(full, "rb") as f:
+                lines.append("{}  {}".format(
+                    reference_hash(f.read(), 32).hex(), sub))
+    return lines
+
+
+def limit_files():
+    resource.setrlimit(resource.RLIMIT_NOFILE, (16, 16))
+
+
+def test_recurse():
+    with tempfile.TemporaryDirectory() as dir:
+        tree = path.join(dir, "tree")
+        # Created out of name order, so that directory order differs.
+        for sub in ["zeta", "alpha/beta", "alpha/Gamma", "mid", "empty"]:
+            os.makedirs(path.join(tree, sub))
+        for i, name in enumerate(["zeta/b", "zeta/a", "mid/x", "alpha/z",
+                                  "alpha/beta/q", "alpha/Gamma/p", "top",
+                                  "Top", "a.b", "a-b"]):
+            with open(path.join(tree, name), "wb") as f:
+                f.write(make_test_input(i * 5000))
+        os.symlink("top", path.join(tree, "link"))
+        os.symlink("alpha", path.join(tree, "dirlink"))
+        os.mkfifo(path.join(tree, "fifo"))
+        expected = expected_walk(dir, "tree")
+        assert len(expected) == 10
+        for args in [["-r", "tree"], ["-j", "4", "-r", "tree"]]:
+            out = run_b3sum(args, cwd=dir)
+            assert out == (0, "".join(l + "\n" for l in expected).encode(),
+                           b""), "b3sum {}: {}".format(" ".join(args), out)
+        out = run_b3sum(["-r", "tree/"], cwd=dir)
+        assert out[1].decode().splitlines() == expected_walk(dir, "tree/"), \
+            "b3sum -r tree/: {}".format(out)
+
+        # Files and directories can be mixed, in argument order.
+        with open(path.join(dir, "tree/top"), "rb") as f:
+            top = "{}  tree/top".format(reference_hash(f.read(), 32).hex())
+        for jobs in ["1", "4"]:
+            out = run_b3sum(
+                ["-j", jobs, "-r", "tree/top", "tree/mid", "nosuchdir"],
+                cwd=dir)
+            assert out[0] == 1 and out[1].decode().splitlines() == \
+                [top] + expected_walk(dir, "tree/mid") and \
+                b"nosuchdir" in out[2], "b3sum -r mixed: {}".format(out)
+
+        # A link given as an argument is followed, unlike those below it.
+        out = run_b3sum(["-r", "tree/dirlink"], cwd=dir)
+        assert out[0] == 0 and out[1].decode().splitlines() == [
+            l.replace("tree/alpha/", "tree/dirlink/")
+            for l in expected_walk(dir, "tree/alpha")
+        ], "b3sum -r tree/dirlink: {}".format(out)
+
+        # A tree deeper than the file descriptor limit.
+        deep = path.join(dir, "deep")
+        os.makedirs(path.join(deep, *(["d"] * 40)))
+        with open(path.join(deep, *(["d"] * 40 + ["f"])), "wb") as f:
+            f.write(b"deep")
+        out = subprocess.run([path.abspath(path.join(HERE, "b3sum")), "-r",
+                              "deep"],
+                             stdout=subprocess.PIPE,
+                             stderr=subprocess.PIPE,
+                             cwd=dir,
+                             preexec_fn=limit_files)
+        assert out.returncode == 0 and out.stdout.decode().splitlines() == \
+            expected_walk(dir, "deep"), "b3sum -r deep: {}".format(out)
+
+
+# Direct I/O must give the same sums, including for lengths that aren't a
+# multiple of the alignment. /tmp is often tmpfs, which rejects O_DIRECT,
+# so the files are also written next to b3sum.
+def test_direct():
+    for base in [None, HERE]:
+        with tempfile.TemporaryDirectory(dir=base) as dir:
+            lines = []
+            names = []
+            for size in [0, 100, 4096, 4097, 65536 + 17, (1 << 20) + 1,
+                         3 * (1 << 20) - 5]:
+                name = "size{}".format(size)
+                input = make_test_input(size)
+                with open(path.join(dir, name), "wb") as f:
+                    f.write(input)
+                names.append(name)
+                lines.append("{}  {}".format(
+                    reference_hash(input, 32).hex(), name))
+            expected = (0, "".join(l + "\n" for l in lines).encode(), b"")
+            for args in [["-d"], ["-d", "-j", "4"]]:
+                out = run_b3sum(args + names, cwd=dir)
+                assert out == expected, "b3sum {}: {}".format(
+                    " ".join(args), out)
+            with open(path.join(dir, "list"), "wb") as f:
+                f.write(expected[1])
+            out = run_b3sum(["-d", "-c", "list"], cwd=dir)
+            assert out[0] == 0 and out[1].decode().splitlines() == \
+                [n + ": OK" for n in names], "b3sum -d -c: {}".format(out)
+            out = run_b3sum(["-d"], make_test_input(5000))
+            assert out[1].decode() == "{}  <stdin>\n".format(
+                reference_hash(make_test_input(5000), 32).hex())
+
+
 def main():
     for case in TEST_VECTORS["cases"]:
         input_len = case["input_len"]
@@ -58,6 +484,20 @@ def main():
                 "hash_xof({}): {} != {}".format(
                     input_len, expected_hash_xof, line)
 
+        # Test longer extended hashes against the reference, on every backend,
+        # so that each wide XOF kernel runs. The reference must agree with
+        # the test vector first.
+        assert reference_hash(input, xof_len).hex() == expected_hash_xof, \
+            "reference_hash({})".format(input_len)
+        for xof_len in XOF_LENS:
+            expected = reference_hash(input, xof_len).hex()
+            for backend in BACKENDS:
+                env = dict(os.environ, BLAKE3_BACKEND=backend)
+                line = run_blake3(["-l", str(xof_len)], input, env)
+                assert expected == line, \
+                    "hash_xof({}, {}, {}): {} != {}".format(
+                        input_len, xof_len, backend, expected, line)
+
         # Test the default keyed hash.
         #test_keyed_hash = run_blake3(["--keyed", hex_key], input)
         #for line in test_keyed_hash.splitlines():
@@ -92,6 +532,12 @@ def main():
         #        "derive_key_xof({}): {} != {}".format(
         #            input_len, expected_derive_key_xof, line)
 
+    test_jobs()
+    test_check()
+    test_cache()
+    test_recurse()
+    test_direct()
+
 
 if __name__ == "__main__":
     main()